@@ -1,11 +1,17 @@
 #include "Action.hpp"
-#include <functional>
-#include <iostream>
+#include <utility>
 
 template <typename T>
-Action<T>::Action(std::function<T> func, int cost)
-	: callback(func)
-	, cost(cost)
+Action<T>::Action(Callback func, int cost)
+	: cost(cost)
+	, callback(std::move(func))
+{
+}
+
+template <typename T>
+Action<T>::Action(Action &&other)
+	: cost(other.cost)
+	, callback(std::move(other.callback))
 {
 }
 
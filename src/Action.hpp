@@ -1,17 +1,21 @@
 #ifndef ACTION_HPP
 #define ACTION_HPP
 
-#include <functional>
+#include "InlineFunction.hpp"
 
+//move-only, so a callback is stored once and run in place
 template <typename T>
 class Action
 {
 public:
+	typedef InlineFunction<T> Callback;
+
 	const int cost;
-	Action(std::function<T> func, int cost);
+	Action(Callback func, int cost);
+	Action(Action &&other);
 	void run() const;
 private:
-	const std::function<T> callback;
+	Callback callback;
 };
 
 #endif
@@ -0,0 +1,170 @@
+#include "ActionBlender.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const float DEGREES_TO_RADIANS = 3.14159265f / 180.f;
+}
+
+ActionBlender::ActionBlender(float trackWidth, float maxVelocity, float maxAcceleration, float maxJerk, float period,
+                             float maxTurn, float radius)
+	: trackWidth(trackWidth)
+	, maxVelocity(maxVelocity)
+	, maxAcceleration(maxAcceleration)
+	, maxJerk(maxJerk)
+	, period(period)
+	, maxTurn(maxTurn)
+	, radius(radius)
+	, actionCount(0)
+	, pieceCount(0)
+	, count(0)
+{
+}
+
+void ActionBlender::begin()
+{
+	actionCount = 0;
+	pieceCount = 0;
+	count = 0;
+}
+
+bool ActionBlender::add(const DriveAction &action)
+{
+	if (actionCount == MAX_ACTIONS)
+		return false;
+
+	const DriveAction *previous = actionCount > 0 ? &actions[actionCount - 1] : nullptr;
+	bool joins = false;
+	if (action.type == DriveAction::Move)
+	{
+		//moves join moves going the same way, and only forward moves join around a turn
+		if (previous == nullptr || previous->type == DriveAction::Turn)
+			joins = previous == nullptr || action.move.inches > 0;
+		else
+			joins = (action.move.inches > 0) == (previous->move.inches > 0);
+	}
+	else if (action.type == DriveAction::Turn)
+	{
+		joins = previous != nullptr && previous->type == DriveAction::Move && previous->move.inches > 0
+		     && std::abs(action.turn.degrees) <= maxTurn;
+	}
+
+	if (joins)
+		actions[actionCount++] = action;
+	return joins;
+}
+
+int ActionBlender::generate()
+{
+	//a turn with no move after it is left for the turn controller
+	int used = actionCount;
+	if (used > 0 && actions[used - 1].type == DriveAction::Turn)
+		used--;
+	if (used < 2)
+		return 0;
+
+	float motorVelocity = 1;
+	float tightest = 0;
+	pieceCount = 0;
+	for (int i = 0; i < used; i++)
+	{
+		const DriveAction &action = actions[i];
+		if (action.type == DriveAction::Move)
+		{
+			motorVelocity = std::min(motorVelocity, std::abs(action.move.motorVelocity));
+			Piece straight = { action.move.inches, 0 };
+			pieces[pieceCount++] = straight;
+			continue;
+		}
+
+		//the arc starts and ends tangentLength from the corner, using at most half of either leg
+		float angle = action.turn.degrees * DEGREES_TO_RADIANS;
+		if (angle == 0)
+			continue;
+		float halfTan = std::tan(std::abs(angle) / 2);
+		Piece &before = pieces[pieceCount - 1];
+		float after = actions[i + 1].move.inches;
+		float arcRadius = std::min(radius, std::min(before.length, after) / 2 / halfTan);
+		float tangentLength = arcRadius * halfTan;
+
+		before.length -= tangentLength;
+		actions[i + 1].move.inches -= tangentLength;
+		Piece arc = { arcRadius * std::abs(angle), angle };
+		pieces[pieceCount++] = arc;
+		tightest = tightest == 0 ? arcRadius : std::min(tightest, arcRadius);
+	}
+
+	float total = 0;
+	for (int i = 0; i < pieceCount; i++)
+		total += pieces[i].length;
+
+	//the outside wheel of the tightest arc sets the speed of the whole run
+	float velocity = motorVelocity * maxVelocity;
+	if (tightest > 0)
+		velocity /= 1 + trackWidth / 2 / tightest;
+	if (!centerline.generate(total, velocity, maxAcceleration, maxJerk, period))
+		return 0;
+
+	count = centerline.size();
+	for (int i = 0; i < count; i++)
+	{
+		const ProfileSample &sample = centerline.getSample(i);
+		float curvature = 0;
+		float rotation = rotationAt(std::abs(sample.position), curvature);
+		float offset = trackWidth / 2 * rotation;
+		float scale = trackWidth / 2 * curvature;
+
+		//turning right, the left wheel travels further
+		left[i].position = sample.position + offset;
+		left[i].velocity = sample.velocity * (1 + scale);
+		left[i].acceleration = sample.acceleration * (1 + scale);
+		right[i].position = sample.position - offset;
+		right[i].velocity = sample.velocity * (1 - scale);
+		right[i].acceleration = sample.acceleration * (1 - scale);
+	}
+	return used;
+}
+
+//radians turned to the right after distance along the centerline, and the curvature there
+float ActionBlender::rotationAt(float distance, float &curvature) const
+{
+	float rotation = 0;
+	curvature = 0;
+	for (int i = 0; i < pieceCount; i++)
+	{
+		const Piece &piece = pieces[i];
+		if (distance <= piece.length)
+		{
+			if (piece.turn != 0)
+			{
+				curvature = piece.turn / piece.length;
+				rotation += curvature * distance;
+			}
+			return rotation;
+		}
+		distance -= piece.length;
+		rotation += piece.turn;
+	}
+	return rotation;
+}
+
+const ProfileSample* ActionBlender::getLeft() const
+{
+	return left.data();
+}
+
+const ProfileSample* ActionBlender::getRight() const
+{
+	return right.data();
+}
+
+int ActionBlender::size() const
+{
+	return count;
+}
+
+float ActionBlender::getPeriod() const
+{
+	return period;
+}
@@ -0,0 +1,70 @@
+#ifndef ACTION_BLENDER_HPP
+#define ACTION_BLENDER_HPP
+
+#include <array>
+#include "DriveAction.hpp"
+#include "MotionProfile.hpp"
+
+/**
+ * Joins a run of queued Moves and shallow Turns into one continuous maneuver.
+ * Each Turn between two forward Moves becomes an arc tangent to both legs,
+ * so the robot ends where the stop-and-go version would without slowing
+ * down at the corners. The run is profiled once along its centerline and
+ * split into left and right wheel distances for DriveAuto's followers.
+ */
+class ActionBlender
+{
+public:
+	static const int MAX_ACTIONS = 9; //five legs joined by four turns
+
+	ActionBlender(float trackWidth, float maxVelocity, float maxAcceleration, float maxJerk, float period,
+	              float maxTurn, float radius);
+
+	void begin();
+	bool add(const DriveAction &action); //false when the action can't join the run, which then ends
+	int generate(); //actions covered by the profiles, 0 when there is nothing worth blending
+
+	const ProfileSample* getLeft() const;
+	const ProfileSample* getRight() const;
+	int size() const;
+	float getPeriod() const;
+
+	//adds every action from the front of the queue that can join, then generates
+	template <typename Queue>
+	int plan(const Queue &queue)
+	{
+		begin();
+		for (std::size_t i = 0; i < queue.size() && add(queue.peek(i)); i++)
+			;
+		return generate();
+	}
+
+private:
+	struct Piece
+	{
+		float length;    //along the centerline
+		float turn;      //radians to the right over the piece, 0 for a straight
+	};
+
+	float rotationAt(float distance, float &curvature) const;
+
+	const float trackWidth;
+	const float maxVelocity;
+	const float maxAcceleration;
+	const float maxJerk;
+	const float period;
+	const float maxTurn;
+	const float radius;
+
+	std::array<DriveAction, MAX_ACTIONS> actions;
+	int actionCount;
+	std::array<Piece, MAX_ACTIONS> pieces;
+	int pieceCount;
+
+	MotionProfile centerline;
+	std::array<ProfileSample, MotionProfile::MAX_SAMPLES> left;
+	std::array<ProfileSample, MotionProfile::MAX_SAMPLES> right;
+	int count;
+};
+
+#endif
@@ -1,29 +1,130 @@
-#include "WPILib.h"
 #include "ActionMap.hpp"
 #include <utility>
 
+const int ActionMap::BUTTONS;
+const int ActionMap::EDGES;
+const int ActionMap::MAX_COMBOS;
+
+//the FPGA clock counts microseconds, so a hold within one tick of its time is complete
+const double HOLD_SLACK = 1e-6;
+
 ActionMap::ActionMap()
+	: comboCount(0)
 {
 }
 
 void ActionMap::associate(JoyButton button, Action<void()> action)
 {
-	std::pair<JoyButton, Action<void()>> buttonPair(button, action);
-	buttonMap.insert(buttonPair);
+	if (button.isCombo())
+	{
+		associateCombo(ButtonEdges::bit(button.name) | button.chord, button.holdSeconds, std::move(action));
+		return;
+	}
+
+	std::size_t index = actions.size();
+	actions.push_back(std::move(action));
+	if (button.down)
+		bind(button.name, ButtonEdge::Down, index);
+	if (button.pressed)
+		bind(button.name, ButtonEdge::Pressed, index);
+	if (button.up)
+		bind(button.name, ButtonEdge::Up, index);
 }
 
-bool ActionMap::eventOccurredFor(JoyButton button)
+void ActionMap::associate(int button, ButtonEdge edge, Action<void()> action)
 {
-	if (buttonMap.find(button) == buttonMap.end())
-	{
+	if (button < 1 || button > BUTTONS)
+		return;
+	actions.push_back(std::move(action));
+	bind(button, edge, actions.size() - 1);
+}
+
+bool ActionMap::associateCombo(uint32_t buttons, float holdSeconds, Action<void()> action)
+{
+	if (comboCount == MAX_COMBOS || buttons == 0)
 		return false;
-	}
-	else
+
+	actions.push_back(std::move(action));
+	Combo &combo = combos[comboCount++];
+	combo.buttons = buttons;
+	combo.holdSeconds = holdSeconds;
+	combo.since = -1;
+	combo.fired = false;
+	combo.action = actions.size() - 1;
+	return true;
+}
+
+void ActionMap::bind(int button, ButtonEdge edge, std::size_t action)
+{
+	if (button < 1 || button > BUTTONS || action >= actions.size())
+		return;
+	slots[(button - 1) * EDGES + static_cast<int>(edge)].push_back(action);
+}
+
+const ActionMap::Slot& ActionMap::slot(int button, ButtonEdge edge) const
+{
+	return slots[(button - 1) * EDGES + static_cast<int>(edge)];
+}
+
+int ActionMap::fire(int button, ButtonEdge edge) const
+{
+	if (button < 1 || button > BUTTONS)
+		return 0;
+
+	const Slot &bound = slot(button, edge);
+	for (std::size_t index : bound)
+		actions[index].run();
+	return bound.size();
+}
+
+int ActionMap::dispatch(const ButtonEdges &edges) const
+{
+	const uint32_t BOUND = (1u << BUTTONS) - 1;
+	const ButtonEdge ALL_EDGES[] = { ButtonEdge::Down, ButtonEdge::Pressed, ButtonEdge::Up };
+
+	int ran = 0;
+	for (ButtonEdge edge : ALL_EDGES)
 	{
-		auto action = buttonMap.find(button)->second;
-		action.run();
-		return true;
+		//visit only the set bits, lowest button first
+		for (uint32_t mask = edges.mask(edge) & BOUND; mask != 0; mask &= mask - 1)
+			ran += fire(__builtin_ctz(mask) + 1, edge);
 	}
+	return ran;
 }
 
+std::size_t ActionMap::size(int button, ButtonEdge edge) const
+{
+	if (button < 1 || button > BUTTONS)
+		return 0;
+	return slot(button, edge).size();
+}
 
+bool ActionMap::empty() const
+{
+	return actions.empty();
+}
+
+int ActionMap::update(uint32_t held, double now)
+{
+	int ran = 0;
+	for (int i = 0; i < comboCount; i++)
+	{
+		Combo &combo = combos[i];
+		if ((held & combo.buttons) != combo.buttons)
+		{
+			combo.since = -1;
+			combo.fired = false;
+			continue;
+		}
+
+		if (combo.since < 0)
+			combo.since = now;
+		if (!combo.fired && now - combo.since + HOLD_SLACK >= combo.holdSeconds)
+		{
+			combo.fired = true;
+			actions[combo.action].run();
+			ran++;
+		}
+	}
+	return ran;
+}
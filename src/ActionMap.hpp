@@ -3,17 +3,57 @@
 
 #include "Action.hpp"
 #include "JoyButton.hpp"
-#include <utility>
+#include "ButtonEdges.hpp"
+#include <array>
+#include <vector>
 
+/**
+ * Callbacks for one controller, in a dense table indexed by button and edge.
+ * Each slot can hold several callbacks, and dispatch runs them in place.
+ * Actions are stored once and slots refer to them by index, so one action can cover several edges.
+ * A binding runs only on the edges it names. Commands that must repeat every loop the button is
+ * held, like ToteLifter's manual moves, bind both down and pressed (JoyButton::whileHeld).
+ * Chords and holds live in a small fixed table checked against the held buttons each loop.
+ * They fire once per hold, and the buttons' own edge bindings still run.
+ */
 class ActionMap
 {
 public:
+	static const int BUTTONS = 12;
+	static const int EDGES = 3;
+	static const int MAX_COMBOS = 8;
+
 	ActionMap();
 
+	//binds action to every edge flagged in button, or to its chord and hold time
 	void associate(JoyButton button, Action<void()> action);
-	bool eventOccurredFor(JoyButton button);
+	void associate(int button, ButtonEdge edge, Action<void()> action);
+	bool associateCombo(uint32_t buttons, float holdSeconds, Action<void()> action); //false when the combo table is full
+
+	int dispatch(const ButtonEdges &edges) const; //runs everything bound to this poll's edges, returns how many ran
+	int update(uint32_t held, double now); //runs chords and holds that completed this loop, now is the loop's timestamp
+	int fire(int button, ButtonEdge edge) const;
+	std::size_t size(int button, ButtonEdge edge) const;
+	bool empty() const;
+
 private:
-	std::map<JoyButton, Action<void()> > buttonMap;
+	struct Combo
+	{
+		uint32_t buttons;
+		float holdSeconds;
+		double since;     //when every button in the combo was first held, negative while it isn't
+		bool fired;
+		std::size_t action;
+	};
+
+	typedef std::vector<std::size_t> Slot;
+	const Slot& slot(int button, ButtonEdge edge) const;
+	void bind(int button, ButtonEdge edge, std::size_t action);
+
+	std::vector<Action<void()> > actions;
+	std::array<Slot, BUTTONS * EDGES> slots;
+	std::array<Combo, MAX_COMBOS> combos;
+	int comboCount;
 };
 
 #endif
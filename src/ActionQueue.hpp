@@ -0,0 +1,101 @@
+#ifndef ACTION_QUEUE_HPP
+#define ACTION_QUEUE_HPP
+
+#include <array>
+#include <cstddef>
+
+/**
+ * Fixed-capacity FIFO backed by a ring buffer.
+ * All storage lives inside the object, so pushing and popping never allocates.
+ */
+template <typename T, std::size_t Capacity>
+class ActionQueue
+{
+public:
+	ActionQueue()
+		: head(0)
+		, count(0)
+		, highWater(0)
+	{
+	}
+
+	bool push(const T& action) //returns false and drops the action when full
+	{
+		if (count == Capacity)
+			return false;
+
+		buffer[(head + count) % Capacity] = action;
+		count++;
+		if (count > highWater)
+			highWater = count;
+		return true;
+	}
+
+	void pop()
+	{
+		if (count == 0)
+			return;
+
+		head = (head + 1) % Capacity;
+		count--;
+	}
+
+	T& front()
+	{
+		return buffer[head];
+	}
+
+	const T& front() const
+	{
+		return buffer[head];
+	}
+
+	T& peek(std::size_t offset) //offset 0 is the front of the queue
+	{
+		return buffer[(head + offset) % Capacity];
+	}
+
+	const T& peek(std::size_t offset) const
+	{
+		return buffer[(head + offset) % Capacity];
+	}
+
+	void clear()
+	{
+		head = 0;
+		count = 0;
+	}
+
+	bool empty() const
+	{
+		return count == 0;
+	}
+
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	std::size_t highWaterMark() const
+	{
+		return highWater;
+	}
+
+	void resetHighWaterMark()
+	{
+		highWater = count;
+	}
+
+	static std::size_t capacity()
+	{
+		return Capacity;
+	}
+
+private:
+	std::array<T, Capacity> buffer;
+	std::size_t head;
+	std::size_t count;
+	std::size_t highWater;
+};
+
+#endif
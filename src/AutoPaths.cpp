@@ -0,0 +1,93 @@
+#include "AutoPaths.hpp"
+#include "PathPlanner.hpp"
+#include "DriveConstants.hpp"
+#include <cstring>
+
+namespace
+{
+	//bump when PathPlanner changes what it makes from the same waypoints, so cached plans are redone
+	const unsigned int PLANNER_REVISION = 1;
+
+	struct NamedPath
+	{
+		const char *name;
+		std::vector<Waypoint> waypoints;
+	};
+
+	std::vector<NamedPath> paths()
+	{
+		//straight into the auto zone
+		Waypoint zoneStart = { 0, 0, 0 }, zoneEnd = { 100, 0, 0 };
+		//swing around the container to the right and end parallel to the start
+		Waypoint sweepStart = { 0, 0, 0 }, sweepMiddle = { 60, -30, -45 }, sweepEnd = { 120, -60, 0 };
+
+		return {
+			{ "AutoZone", { zoneStart, zoneEnd } },
+			{ "SweepRight", { sweepStart, sweepMiddle, sweepEnd } },
+		};
+	}
+
+	//FNV-1a
+	void hash(unsigned int &h, const void *data, std::size_t size)
+	{
+		const unsigned char *bytes = static_cast<const unsigned char*>(data);
+		for (std::size_t i = 0; i < size; i++)
+			h = (h ^ bytes[i]) * 16777619u;
+	}
+
+	void add(const PathPlanner &planner, const char *name, const std::vector<Waypoint> &waypoints, std::vector<Trajectory> &trajectories)
+	{
+		Trajectory trajectory;
+		if (planner.plan(waypoints, trajectory))
+		{
+			trajectory.name = name;
+			trajectories.push_back(trajectory);
+		}
+	}
+}
+
+std::vector<Trajectory> AutoPaths::build()
+{
+	using namespace DriveConstants;
+	PathPlanner planner(TRACK_WIDTH, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD);
+	std::vector<Trajectory> trajectories;
+	for (const NamedPath &path : paths())
+		add(planner, path.name, path.waypoints, trajectories);
+	return trajectories;
+}
+
+std::vector<Waypoint> AutoPaths::waypoints(const std::string &name)
+{
+	for (const NamedPath &path : paths())
+	{
+		if (name == path.name)
+			return path.waypoints;
+	}
+	return std::vector<Waypoint>();
+}
+
+unsigned int AutoPaths::sourceHash()
+{
+	using namespace DriveConstants;
+	const float constants[] = { TRACK_WIDTH, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD };
+	unsigned int h = 2166136261u;
+	hash(h, &PLANNER_REVISION, sizeof(PLANNER_REVISION));
+	hash(h, constants, sizeof(constants));
+	for (const NamedPath &path : paths())
+	{
+		hash(h, path.name, std::strlen(path.name) + 1);
+		for (const Waypoint &waypoint : path.waypoints)
+			hash(h, &waypoint, sizeof(waypoint));
+	}
+	return h;
+}
+
+std::vector<PursuitPoint> AutoPaths::buildSweepPursuit()
+{
+	using namespace DriveConstants;
+	PathPlanner planner(TRACK_WIDTH, PURSUIT_MAX_VELOCITY, PURSUIT_MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD);
+	std::vector<PursuitPoint> points;
+
+	planner.planPoints(waypoints("SweepRight"), PURSUIT_SPACING, points);
+	return points;
+}
@@ -0,0 +1,21 @@
+#ifndef AUTO_PATHS_HPP
+#define AUTO_PATHS_HPP
+
+#include <string>
+#include <vector>
+#include "Trajectory.hpp"
+#include "PurePursuit.hpp"
+#include "PathPlanner.hpp"
+
+//Spline paths for autonomous, planned into the trajectory cache file
+namespace AutoPaths
+{
+	const char* const CACHE_FILE = "/home/lvuser/trajectories.bin";
+
+	std::vector<Trajectory> build();
+	std::vector<Waypoint> waypoints(const std::string &name); //of one of build()'s paths, empty for an unknown name
+	unsigned int sourceHash(); //of the waypoints and planner constants build() uses, stored in the cache file
+	std::vector<PursuitPoint> buildSweepPursuit(); //SweepRight as points for DriveAuto::followPath
+}
+
+#endif
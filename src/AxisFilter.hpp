@@ -0,0 +1,222 @@
+#ifndef AXIS_FILTER_HPP
+#define AXIS_FILTER_HPP
+
+#include <cmath>
+
+/**
+ * Joystick axis shaping stages, chained at compile time by AxisFilter.
+ * Every stage is O(1) per sample, keeps its state inline and never allocates.
+ * Stages provide
+ *   float operator()(float x) - the next output
+ *   float settle(float x)     - what the output settles to if x is held
+ *   void reset()
+ */
+
+//zeroes the middle of the stick, then rescales so the output still starts at 0 and ends at 1
+struct ScaledDeadband
+{
+	float width;
+
+	explicit ScaledDeadband(float width)
+		: width(width)
+	{
+	}
+
+	float operator()(float x) const
+	{
+		return settle(x);
+	}
+
+	float settle(float x) const
+	{
+		float magnitude = std::abs(x);
+		if (magnitude <= width)
+			return 0;
+		float scaled = (magnitude - width) / (1 - width);
+		return x < 0 ? -scaled : scaled;
+	}
+
+	void reset()
+	{
+	}
+};
+
+//blends linear and cubic response, 0 is linear and 1 is fully cubic
+struct Expo
+{
+	float amount;
+
+	explicit Expo(float amount)
+		: amount(amount)
+	{
+	}
+
+	float operator()(float x) const
+	{
+		return settle(x);
+	}
+
+	float settle(float x) const
+	{
+		return (1 - amount) * x + amount * x * x * x;
+	}
+
+	void reset()
+	{
+	}
+};
+
+//limits how far the output moves per sample, a full stick reversal takes 2 / maxStep samples
+struct SlewLimiter
+{
+	float maxStep;
+	float last;
+
+	explicit SlewLimiter(float maxStep)
+		: maxStep(maxStep)
+		, last(0)
+	{
+	}
+
+	float operator()(float x)
+	{
+		float step = x - last;
+		if (step > maxStep)
+			step = maxStep;
+		else if (step < -maxStep)
+			step = -maxStep;
+		last += step;
+		return last;
+	}
+
+	float settle(float x) const
+	{
+		return x;
+	}
+
+	void reset()
+	{
+		last = 0;
+	}
+};
+
+//first order low pass, alpha 1 passes the input straight through
+struct OnePole
+{
+	float alpha;
+	float state;
+
+	explicit OnePole(float alpha)
+		: alpha(alpha)
+		, state(0)
+	{
+	}
+
+	float operator()(float x)
+	{
+		state += alpha * (x - state);
+		return state;
+	}
+
+	float settle(float x) const
+	{
+		return x;
+	}
+
+	void reset()
+	{
+		state = 0;
+	}
+};
+
+//median of the last three samples, drops single-sample spikes for one sample of delay
+struct Median3
+{
+	float a;
+	float b;
+
+	Median3()
+		: a(0)
+		, b(0)
+	{
+	}
+
+	float operator()(float x)
+	{
+		float median = std::fmax(std::fmin(a, b), std::fmin(std::fmax(a, b), x));
+		a = b;
+		b = x;
+		return median;
+	}
+
+	float settle(float x) const
+	{
+		return x;
+	}
+
+	void reset()
+	{
+		a = 0;
+		b = 0;
+	}
+};
+
+/**
+ * Runs a sample through each stage in order, e.g.
+ *   AxisFilter<ScaledDeadband, Expo, SlewLimiter> drive(ScaledDeadband(0.1), Expo(0.3), SlewLimiter(0.25));
+ * The chain is resolved at compile time, so a call is just the stages' arithmetic inlined.
+ */
+template <typename... Stages>
+class AxisFilter;
+
+template <>
+class AxisFilter<>
+{
+public:
+	float operator()(float x)
+	{
+		return x;
+	}
+
+	float settle(float x) const
+	{
+		return x;
+	}
+
+	void reset()
+	{
+	}
+};
+
+template <typename First, typename... Rest>
+class AxisFilter<First, Rest...>
+{
+public:
+	AxisFilter(First first, Rest... rest)
+		: stage(first)
+		, rest(rest...)
+	{
+	}
+
+	float operator()(float x)
+	{
+		return rest(stage(x));
+	}
+
+	float settle(float x) const
+	{
+		return rest.settle(stage.settle(x));
+	}
+
+	void reset()
+	{
+		stage.reset();
+		rest.reset();
+	}
+
+private:
+	First stage;
+	AxisFilter<Rest...> rest;
+};
+
+#endif
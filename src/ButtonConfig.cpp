@@ -0,0 +1,194 @@
+#include "ButtonConfig.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <utility>
+
+namespace
+{
+	const char *BUTTON_NAMES[ActionMap::BUTTONS] = {
+		"Trigger", "SideButton", "BottomLeft", "BottomRight", "TopLeft", "TopRight",
+		"Button7", "Button8", "Button9", "Button10", "Button11", "Button12"
+	};
+
+	std::string lineError(int line, const std::string &message)
+	{
+		std::ostringstream out;
+		out << "line " << line << ": " << message;
+		return out.str();
+	}
+}
+
+ButtonConfig::ButtonConfig()
+{
+	loaded.modified = 0;
+	loaded.size = -1;
+}
+
+void ButtonConfig::addDevice(const std::string &name, int port)
+{
+	devices[name] = port;
+}
+
+void ButtonConfig::addCommand(const std::string &name, Command command)
+{
+	commands.push_back(std::move(command));
+	commandNames[name] = &commands.back();
+}
+
+std::unique_ptr<InputBus> ButtonConfig::build(std::istream &in, std::vector<std::string> &errors) const
+{
+	std::unique_ptr<InputBus> bus(new InputBus());
+	std::size_t firstError = errors.size();
+
+	std::string text;
+	for (int line = 1; std::getline(in, text); line++)
+	{
+		std::size_t comment = text.find('#');
+		if (comment != std::string::npos)
+			text.erase(comment);
+
+		std::istringstream tokens(text);
+		std::string deviceName, buttonNames, edgeName, commandName;
+		if (!(tokens >> deviceName))
+			continue;
+		if (!(tokens >> buttonNames >> edgeName))
+		{
+			errors.push_back(lineError(line, "expected <device> <button> <edge> <command>"));
+			continue;
+		}
+
+		auto device = devices.find(deviceName);
+		if (device == devices.end())
+		{
+			errors.push_back(lineError(line, "unknown device '" + deviceName + "'"));
+			continue;
+		}
+
+		//first button names the binding, the rest of a chord must be held with it
+		JoyButton button;
+		uint32_t chord = 0;
+		bool buttonsOk = true;
+		std::istringstream chordNames(buttonNames);
+		std::string buttonName;
+		for (int count = 0; std::getline(chordNames, buttonName, '+'); count++)
+		{
+			int number;
+			if (!parseButton(buttonName, number))
+			{
+				errors.push_back(lineError(line, "unknown button '" + buttonName + "'"));
+				buttonsOk = false;
+				break;
+			}
+			if (count == 0)
+				button.name = static_cast<ButtonNames>(number);
+			else
+				chord |= ButtonEdges::bit(number);
+		}
+		if (!buttonsOk)
+			continue;
+		button.chord = chord;
+
+		if (edgeName == "down")
+			button.down = true;
+		else if (edgeName == "pressed")
+			button.pressed = true;
+		else if (edgeName == "up")
+			button.up = true;
+		else if (edgeName == "while")
+		{
+			button.down = true;
+			button.pressed = true;
+		}
+		else if (edgeName == "held")
+		{
+			if (!(tokens >> button.holdSeconds) || button.holdSeconds <= 0)
+			{
+				errors.push_back(lineError(line, "held needs a time in seconds"));
+				continue;
+			}
+		}
+		else
+		{
+			errors.push_back(lineError(line, "unknown edge '" + edgeName + "', expected down, pressed, up, while or held"));
+			continue;
+		}
+
+		if (chord != 0 && (button.pressed || button.up))
+		{
+			errors.push_back(lineError(line, "chords fire once when complete, use down or held"));
+			continue;
+		}
+
+		if (!(tokens >> commandName))
+		{
+			errors.push_back(lineError(line, "missing command"));
+			continue;
+		}
+		auto command = commandNames.find(commandName);
+		if (command == commandNames.end())
+		{
+			errors.push_back(lineError(line, "unknown command '" + commandName + "'"));
+			continue;
+		}
+
+		const Command *bound = command->second;
+		bus->subscribe(device->second, button, Action<void()>([bound]() { (*bound)(); }, 0));
+	}
+
+	if (errors.size() != firstError)
+		bus.reset();
+	return bus;
+}
+
+std::unique_ptr<InputBus> ButtonConfig::load(const std::string &file, std::vector<std::string> &errors)
+{
+	std::ifstream in(file);
+	if (!in)
+	{
+		errors.push_back("can't open " + file);
+		return std::unique_ptr<InputBus>();
+	}
+
+	//remembered even when the file has errors, so a broken file isn't reparsed every loop
+	version(file, loaded);
+	return build(in, errors);
+}
+
+bool ButtonConfig::changed(const std::string &file) const
+{
+	FileVersion current;
+	if (!version(file, current))
+		return false;
+	return current.modified != loaded.modified || current.size != loaded.size;
+}
+
+bool ButtonConfig::version(const std::string &file, FileVersion &result)
+{
+	struct stat info;
+	if (stat(file.c_str(), &info) != 0)
+		return false;
+	result.modified = info.st_mtime;
+	result.size = info.st_size;
+	return true;
+}
+
+bool ButtonConfig::parseButton(const std::string &token, int &button)
+{
+	for (int i = 0; i < ActionMap::BUTTONS; i++)
+	{
+		if (token == BUTTON_NAMES[i])
+		{
+			button = i + 1;
+			return true;
+		}
+	}
+
+	char *end;
+	long number = std::strtol(token.c_str(), &end, 10);
+	if (token.empty() || *end != '\0' || number < 1 || number > ActionMap::BUTTONS)
+		return false;
+	button = number;
+	return true;
+}
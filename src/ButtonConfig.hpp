@@ -0,0 +1,54 @@
+#ifndef BUTTON_CONFIG_HPP
+#define BUTTON_CONFIG_HPP
+
+#include "InputBus.hpp"
+#include <ctime>
+#include <deque>
+#include <istream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Builds an InputBus from a text file of bindings, one per line:
+ *   <device> <button>[+<button>...] <down|pressed|up|while|held seconds> <command>
+ * e.g.
+ *   joystick Button7 down shifter.low
+ *   joystick TopRight while lifter.up     (every loop the button is held)
+ *   gamecube TopLeft+Trigger down lifter.override
+ *   gamecube Button9 held 0.3 lifter.up
+ * Devices and commands are names registered in code; buttons are ButtonNames or 1 to 12.
+ * '#' starts a comment. A file with any bad line builds nothing, so a typo never
+ * leaves the robot with half its controls.
+ */
+class ButtonConfig
+{
+public:
+	typedef Action<void()>::Callback Command;
+
+	ButtonConfig();
+	void addDevice(const std::string &name, int port);
+	void addCommand(const std::string &name, Command command);
+
+	std::unique_ptr<InputBus> build(std::istream &in, std::vector<std::string> &errors) const; //null when there are errors
+	std::unique_ptr<InputBus> load(const std::string &file, std::vector<std::string> &errors); //also remembers the file's version
+	bool changed(const std::string &file) const; //modified since the last load
+
+private:
+	struct FileVersion
+	{
+		std::time_t modified;
+		long size;
+	};
+
+	static bool version(const std::string &file, FileVersion &result);
+	static bool parseButton(const std::string &token, int &button);
+
+	std::map<std::string, int> devices;
+	std::map<std::string, const Command*> commandNames;
+	std::deque<Command> commands; //deque so bound commands stay put as more are added
+	FileVersion loaded;
+};
+
+#endif
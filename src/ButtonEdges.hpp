@@ -0,0 +1,70 @@
+#ifndef BUTTON_EDGES_HPP
+#define BUTTON_EDGES_HPP
+
+#include <cstdint>
+
+enum class ButtonEdge
+{
+	Down,
+	Pressed,
+	Up
+};
+
+/**
+ * Down, pressed and up for every button at once, from the driver station's
+ * button word. Bit 0 is button 1.
+ *   down    - held now, not last poll
+ *   pressed - held now and last poll
+ *   up      - released now, held last poll
+ */
+struct ButtonEdges
+{
+	uint32_t down;
+	uint32_t pressed;
+	uint32_t up;
+
+	ButtonEdges()
+		: down(0)
+		, pressed(0)
+		, up(0)
+		, previous(0)
+	{
+	}
+
+	void update(uint32_t buttons)
+	{
+		down = buttons & ~previous;
+		pressed = buttons & previous;
+		up = ~buttons & previous;
+		previous = buttons;
+	}
+
+	uint32_t mask(ButtonEdge edge) const
+	{
+		return edge == ButtonEdge::Down ? down : (edge == ButtonEdge::Pressed ? pressed : up);
+	}
+
+	uint32_t held() const //buttons held down now
+	{
+		return down | pressed;
+	}
+
+	uint32_t any() const //buttons with something to report
+	{
+		return down | pressed | up;
+	}
+
+	static uint32_t bit(int button) //button numbers start at 1, like ButtonNames
+	{
+		return 1u << (button - 1);
+	}
+
+	bool isDown(int button) const { return (down & bit(button)) != 0; }
+	bool isPressed(int button) const { return (pressed & bit(button)) != 0; }
+	bool isUp(int button) const { return (up & bit(button)) != 0; }
+
+private:
+	uint32_t previous;
+};
+
+#endif
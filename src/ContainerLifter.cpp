@@ -2,6 +2,7 @@
 
 ContainerLifter::ContainerLifter(int portA, int portB)
 	: containerS(new DoubleSolenoid(portA, portB))
+	, pistonChannel(Telemetry::get()->channel("ContainerLifter piston", "extended"))
 {
 
 }
@@ -9,12 +10,12 @@ ContainerLifter::ContainerLifter(int portA, int portB)
 void ContainerLifter::extendPiston()
 {
 	containerS->Set(DoubleSolenoid::kForward);
-	std::cout << "Extended Piston" << std::endl;
+	Telemetry::get()->record(pistonChannel, 1);
 }
 
 void ContainerLifter::retractPiston()
 {
 	containerS->Set(DoubleSolenoid::kReverse);
-	std::cout << "Retract Piston" << std::endl;
+	Telemetry::get()->record(pistonChannel, 0);
 }
 
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <WPILib.h>
+#include "Telemetry.hpp"
 
 class ContainerLifter
 {
@@ -12,6 +13,9 @@ public:
 	void extendPiston();
 	void retractPiston();
 	const std::unique_ptr<DoubleSolenoid> containerS;
+
+private:
+	const Telemetry::Channel pistonChannel;
 };
 
 #endif
@@ -0,0 +1,151 @@
+#include "ControlThread.hpp"
+#include <limits>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+namespace
+{
+	const long long NANOSECONDS = 1000000000LL;
+
+	long long toNanoseconds(const timespec &time)
+	{
+		return time.tv_sec * NANOSECONDS + time.tv_nsec;
+	}
+
+	timespec fromNanoseconds(long long ns)
+	{
+		timespec time;
+		time.tv_sec = ns / NANOSECONDS;
+		time.tv_nsec = ns % NANOSECONDS;
+		return time;
+	}
+
+	long long now()
+	{
+		timespec time;
+		clock_gettime(CLOCK_MONOTONIC, &time);
+		return toNanoseconds(time);
+	}
+}
+
+ControlThread::ControlThread(double hz, std::function<void()> step)
+	: periodNs(static_cast<long long>(NANOSECONDS / hz))
+	, step(step)
+	, running(false)
+	, realtime(false)
+{
+	resetStats();
+}
+
+ControlThread::~ControlThread()
+{
+	stop();
+}
+
+bool ControlThread::start(int priority)
+{
+	if (running)
+		return false;
+
+	running = true;
+	thread = std::thread(&ControlThread::run, this);
+
+	//without permission for real-time scheduling the thread still runs, just at normal priority
+	sched_param param;
+	param.sched_priority = priority;
+	realtime = pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param) == 0;
+	return true;
+}
+
+void ControlThread::stop()
+{
+	running = false;
+	if (thread.joinable())
+		thread.join();
+}
+
+bool ControlThread::isRunning() const
+{
+	return running;
+}
+
+bool ControlThread::hasRealtimePriority() const
+{
+	return realtime;
+}
+
+double ControlThread::getRate() const
+{
+	return static_cast<double>(NANOSECONDS) / periodNs;
+}
+
+void ControlThread::run()
+{
+	long long deadline = now();
+	long long lastStart = -1;
+
+	while (running)
+	{
+		timespec wake = fromNanoseconds(deadline);
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr);
+
+		long long start = now();
+		if (lastStart >= 0)
+			record(start - lastStart);
+		lastStart = start;
+
+		step();
+
+		//if we fell behind, skip the missed ticks instead of running them back to back
+		deadline += periodNs;
+		long long finished = now();
+		if (finished > deadline)
+		{
+			overruns++;
+			deadline = skipMissedTicks(deadline, finished, periodNs);
+		}
+	}
+}
+
+long long ControlThread::skipMissedTicks(long long deadline, long long finished, long long periodNs)
+{
+	return finished + periodNs - (finished - deadline) % periodNs;
+}
+
+void ControlThread::record(long long period)
+{
+	long long jitter = period > periodNs ? period - periodNs : periodNs - period;
+
+	//only this thread writes, so plain load/store keeps the statistics consistent enough for readers
+	iterations.store(iterations.load() + 1);
+	totalPeriodNs.store(totalPeriodNs.load() + period);
+	if (period < minPeriodNs.load())
+		minPeriodNs.store(period);
+	if (period > maxPeriodNs.load())
+		maxPeriodNs.store(period);
+	if (jitter > maxJitterNs.load())
+		maxJitterNs.store(jitter);
+}
+
+ControlThread::Stats ControlThread::getStats() const
+{
+	Stats stats;
+	stats.iterations = iterations.load();
+	stats.overruns = overruns.load();
+	stats.meanPeriod = stats.iterations > 0 ? totalPeriodNs.load() / static_cast<double>(stats.iterations) / NANOSECONDS : 0;
+	stats.minPeriod = stats.iterations > 0 ? minPeriodNs.load() / static_cast<double>(NANOSECONDS) : 0;
+	stats.maxPeriod = maxPeriodNs.load() / static_cast<double>(NANOSECONDS);
+	stats.maxJitter = maxJitterNs.load() / static_cast<double>(NANOSECONDS);
+	return stats;
+}
+
+void ControlThread::resetStats()
+{
+	iterations = 0;
+	overruns = 0;
+	totalPeriodNs = 0;
+	minPeriodNs = std::numeric_limits<long long>::max();
+	maxPeriodNs = 0;
+	maxJitterNs = 0;
+}
@@ -0,0 +1,62 @@
+#ifndef CONTROL_THREAD_HPP
+#define CONTROL_THREAD_HPP
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+/**
+ * Calls step() at a fixed rate on its own thread, sleeping until absolute
+ * deadlines so timing errors do not accumulate. Period and jitter of every
+ * iteration are folded into statistics that can be read from any thread.
+ */
+class ControlThread
+{
+public:
+	struct Stats
+	{
+		long long iterations;
+		long long overruns;   //iterations that woke up after the next deadline had already passed
+		double meanPeriod;    //seconds between the starts of consecutive iterations
+		double minPeriod;
+		double maxPeriod;
+		double maxJitter;     //largest difference between a period and the nominal period
+	};
+
+	ControlThread(double hz, std::function<void()> step);
+	~ControlThread();
+
+	bool start(int priority = 40); //priority is SCHED_FIFO, 1 to 99
+	void stop();
+	bool isRunning() const;
+	bool hasRealtimePriority() const;
+	double getRate() const;
+
+	Stats getStats() const;
+	void resetStats();
+
+	//after a step that finished past its deadline, the first tick on the same grid that is still ahead
+	static long long skipMissedTicks(long long deadline, long long finished, long long periodNs);
+
+private:
+	ControlThread(const ControlThread&);
+	ControlThread& operator=(const ControlThread&);
+
+	void run();
+	void record(long long periodNs);
+
+	const long long periodNs;
+	const std::function<void()> step;
+	std::thread thread;
+	std::atomic<bool> running;
+	std::atomic<bool> realtime;
+
+	std::atomic<long long> iterations;
+	std::atomic<long long> overruns;
+	std::atomic<long long> totalPeriodNs;
+	std::atomic<long long> minPeriodNs;
+	std::atomic<long long> maxPeriodNs;
+	std::atomic<long long> maxJitterNs;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef DRIVE_ACTION_HPP
+#define DRIVE_ACTION_HPP
+
+#include "Odometry.hpp"
+
+struct TrajectoryView;
+struct PursuitPath;
+
+/**
+ * A single queued DriveAuto maneuver.
+ * type selects which member of the union holds the parameters.
+ */
+struct DriveAction
+{
+	enum Type
+	{
+		Move,
+		Turn,
+		Wait,
+		ToteAlign,
+		FollowTrajectory,
+		FollowPath
+	};
+
+	struct MoveParams
+	{
+		float inches;
+		float motorVelocity;
+		int profileSlot;     //which of DriveAuto's motion profiles this move follows
+		float leftStart;     //encoder distances when the move began
+		float rightStart;
+	};
+
+	struct TurnParams
+	{
+		float degrees;
+	};
+
+	struct WaitParams
+	{
+		float seconds;
+	};
+
+	struct TrajectoryParams
+	{
+		const TrajectoryView *trajectory;
+		float leftStart;
+		float rightStart;
+	};
+
+	struct PursuitParams
+	{
+		const PursuitPath *path;
+		Pose origin;         //robot pose when the action began, the path is relative to it
+		float lastTime;
+	};
+
+	Type type;
+	union
+	{
+		MoveParams move;
+		TurnParams turn;
+		WaitParams wait;
+		TrajectoryParams path;
+		PursuitParams pursuit;
+	};
+
+	DriveAction()
+		: type(Wait)
+	{
+		wait.seconds = 0;
+	}
+
+	static DriveAction makeMove(float inches, float motorVelocity, int profileSlot)
+	{
+		DriveAction action;
+		action.type = Move;
+		action.move.inches = inches;
+		action.move.motorVelocity = motorVelocity;
+		action.move.profileSlot = profileSlot;
+		action.move.leftStart = 0;
+		action.move.rightStart = 0;
+		return action;
+	}
+
+	static DriveAction makeTurn(float degrees)
+	{
+		DriveAction action;
+		action.type = Turn;
+		action.turn.degrees = degrees;
+		return action;
+	}
+
+	static DriveAction makeWait(float seconds)
+	{
+		DriveAction action;
+		action.type = Wait;
+		action.wait.seconds = seconds;
+		return action;
+	}
+
+	static DriveAction makeTrajectory(const TrajectoryView *trajectory)
+	{
+		DriveAction action;
+		action.type = FollowTrajectory;
+		action.path.trajectory = trajectory;
+		action.path.leftStart = 0;
+		action.path.rightStart = 0;
+		return action;
+	}
+
+	static DriveAction makePursuit(const PursuitPath *path)
+	{
+		DriveAction action;
+		action.type = FollowPath;
+		action.pursuit.path = path;
+		action.pursuit.origin.x = 0;
+		action.pursuit.origin.y = 0;
+		action.pursuit.origin.heading = 0;
+		action.pursuit.lastTime = 0;
+		return action;
+	}
+
+	static DriveAction makeToteAlign()
+	{
+		DriveAction action;
+		action.type = ToteAlign;
+		return action;
+	}
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include <WPILib.h>
 #include "DriveAuto.hpp"
 #include "RobotLocation.hpp"
+#include "DriveConstants.hpp"
 #include <cmath>
 
 const float DISTANCE_DS = 16.291 * 2.54;
@@ -26,16 +27,44 @@ float modification(float offset)
 DriveAuto::DriveAuto()
 	: leftMotors(new TwoMotorGroup(4, 5, true))
 	, rightMotors(new TwoMotorGroup(2, 3, false))
-	, TURN_SPEED(0.35f)
+	, movingAverage(12, 1)
+	, dsLeftController(new ReusablePIDController(RobotLocation::get()->getLeftDistance(), leftMotors.get()))
+	, dsRightController(new ReusablePIDController(RobotLocation::get()->getRightDistance(), rightMotors.get()))
+	, syncController(new ReusablePIDController(RobotLocation::get()->getRightDistance(), rightMotors.get()))
+	, distanceController(new ReusablePIDController(RobotLocation::get()->getLeftDistance(), leftMotors.get()))
+	, profileSlotsInUse(0)
+	, leftFollower(DriveConstants::MOVE_KV, DriveConstants::MOVE_KA, DriveConstants::MOVE_KP, DriveConstants::MOVE_KD,
+	               DriveConstants::MOVE_TOLERANCE, DriveConstants::MOVE_TIMEOUT)
+	, rightFollower(DriveConstants::MOVE_KV, DriveConstants::MOVE_KA, DriveConstants::MOVE_KP, DriveConstants::MOVE_KD,
+	                DriveConstants::MOVE_TOLERANCE, DriveConstants::MOVE_TIMEOUT)
+	, turnController(DriveConstants::TURN_MAX_RATE, DriveConstants::TURN_MAX_ACCELERATION,
+	                 DriveConstants::TURN_KV, DriveConstants::TURN_KP, DriveConstants::TURN_KD, DriveConstants::TURN_MIN_OUTPUT,
+	                 DriveConstants::TURN_TOLERANCE, DriveConstants::TURN_SETTLE_TIME, DriveConstants::TURN_TIMEOUT)
+	, pursuit(DriveConstants::PURSUIT_LOOKAHEAD, DriveConstants::TRACK_WIDTH, DriveConstants::PURSUIT_MAX_VELOCITY,
+	          DriveConstants::PURSUIT_MAX_ACCELERATION, DriveConstants::PURSUIT_TOLERANCE)
+	, blender(DriveConstants::TRACK_WIDTH, DriveConstants::MAX_VELOCITY, DriveConstants::MAX_ACCELERATION,
+	          DriveConstants::MAX_JERK, DriveConstants::PROFILE_PERIOD, DriveConstants::BLEND_MAX_TURN, DriveConstants::BLEND_RADIUS)
+	, blending(true)
+	, blendedActions(1)
+	, encoderChannel(Telemetry::get()->channel("DriveAuto encoders", "left right"))
+	, moveDoneChannel(Telemetry::get()->channel("DriveAuto move done", "seconds actions"))
+	, turnDoneChannel(Telemetry::get()->channel("DriveAuto axis turn done", "target seconds error timedOut"))
+	, commandFullChannel(Telemetry::get()->channel("DriveAuto command queue full, dropped command", ""))
+	, actionFullChannel(Telemetry::get()->channel("DriveAuto action queue full, dropped action", "type"))
+	, noProfileChannel(Telemetry::get()->channel("DriveAuto has no free motion profile, dropped move", "inches"))
+	, tooLongChannel(Telemetry::get()->channel("DriveAuto move too long to profile, dropped", "inches"))
+	, missingPathChannel(Telemetry::get()->channel("DriveAuto was given a missing or empty path", "trajectory"))
+	, threaded(false)
+	, queueDepth(0)
+	, queueHighWaterMark(0)
 {
-	auto rl = RobotLocation::get();
-	rl->getLeftEncoder()->SetPIDSourceParameter(Encoder::kDistance);
-	rl->getRightEncoder()->SetPIDSourceParameter(Encoder::kDistance);
-
 	initiallyStraight = true;
 	initialAngle = true;
 	initialTurn = true;
 	initialAlign = true;
+	leftDistance = 0;
+	rightDistance = 0;
+	lastTurnReport = TurnReport();
 }
 
 DriveAuto* DriveAuto::instance = nullptr;
@@ -57,186 +86,388 @@ const std::shared_ptr<TwoMotorGroup> DriveAuto::getRightMotors()
 	return rightMotors;
 }
 
+//the action queue belongs to whichever thread runs update(), so other threads go through commands
+void DriveAuto::submit(const Command& command)
+{
+	if (!threaded)
+		apply(command);
+	else if (!commands.push(command))
+	{
+		Telemetry::get()->record(commandFullChannel);
+		if (command.hasAction)
+			releaseProfile(command.action);
+	}
+}
+
+void DriveAuto::apply(const Command& command)
+{
+	if (command.clear)
+		clearActions();
+	if (command.hasAction && !actionQueue.push(command.action))
+	{
+		Telemetry::get()->record(actionFullChannel, command.action.type);
+		releaseProfile(command.action);
+	}
+	publishStatus();
+}
+
+void DriveAuto::enqueue(const DriveAction& action)
+{
+	Command command;
+	command.clear = false;
+	command.hasAction = true;
+	command.action = action;
+	submit(command);
+}
+
+void DriveAuto::publishStatus()
+{
+	queueDepth = actionQueue.size();
+	queueHighWaterMark = actionQueue.highWaterMark();
+}
+
+bool DriveAuto::startControlThread(double hz)
+{
+	if (threaded)
+		return false;
+
+	controlThread.reset(new ControlThread(hz, std::bind(&DriveAuto::controlStep, this)));
+	threaded = true;
+	controlThread->start();
+	return true;
+}
+
+void DriveAuto::stopControlThread()
+{
+	if (!threaded)
+		return;
+
+	controlThread->stop();
+	threaded = false;
+
+	//commands that arrived after the last step still need to land
+	Command command;
+	while (commands.pop(command))
+		apply(command);
+}
+
+bool DriveAuto::isThreaded() const
+{
+	return threaded;
+}
+
+ControlThread::Stats DriveAuto::getControlStats() const
+{
+	if (controlThread)
+		return controlThread->getStats();
+
+	ControlThread::Stats none = ControlThread::Stats();
+	return none;
+}
+
+void DriveAuto::controlStep()
+{
+	Command command;
+	while (commands.pop(command))
+		apply(command);
+	update();
+}
+
+//moves hold their profile slot until they leave the queue
+void DriveAuto::popAction()
+{
+	if (actionQueue.empty())
+		return;
+
+	releaseProfile(actionQueue.front());
+	actionQueue.pop();
+	publishStatus();
+}
+
+void DriveAuto::clearActions()
+{
+	//moves still sitting in the command queue keep their profile slots
+	for (std::size_t i = 0; i < actionQueue.size(); i++)
+		releaseProfile(actionQueue.peek(i));
+	actionQueue.clear();
+	initiallyStraight = true;
+	initialTurn = true;
+}
+
+void DriveAuto::releaseProfile(const DriveAction& action)
+{
+	if (action.type == DriveAction::Move)
+		profileSlotsInUse.fetch_and(~(1u << action.move.profileSlot));
+}
+
+std::size_t DriveAuto::getQueueDepth() const
+{
+	return queueDepth;
+}
+
+std::size_t DriveAuto::getQueueHighWaterMark() const
+{
+	return queueHighWaterMark;
+}
+
+TurnReport DriveAuto::getLastTurnReport() const
+{
+	std::lock_guard<std::mutex> lock(reportMutex);
+	return lastTurnReport;
+}
+
+void DriveAuto::setBlending(bool enabled)
+{
+	blending = enabled;
+}
+
+int DriveAuto::getLiveControllerCount()
+{
+	return ReusablePIDController::live();
+}
+
+void DriveAuto::disableControllers()
+{
+	dsLeftController->Disable();
+	dsRightController->Disable();
+	syncController->Disable();
+	distanceController->Disable();
+}
+
 void DriveAuto::move(float inches, float motorVelocity)
 {
-	std::pair<DriveActions, std::vector<float> > moveAction;
-	moveAction.first = DriveActions::Move;
-	std::vector<float> params;  //stores inches and motorVelocity
-	params.push_back(inches);
-	params.push_back(motorVelocity);
-	float currentDistance = RobotLocation::get()->getLeftEncoder()->GetDistance();
-	params.push_back(currentDistance);
-	moveAction.second = params; //Puts inches & motorVelocity in moveAction
-	actionQueue.push (moveAction); //Stores the params pair and the DriveAction in actionQueue
+	//slots free up out of order when a push fails, so take the lowest free one rather than the next in turn
+	uint32_t inUse = profileSlotsInUse;
+	int slot = 0;
+	while (slot < PROFILE_SLOTS && (inUse & (1u << slot)))
+		slot++;
+	if (slot == PROFILE_SLOTS)
+	{
+		Telemetry::get()->record(noProfileChannel, inches);
+		return;
+	}
 
-	//syncController = new PIDController(0.00009f, 0.0f, 0.0f, 0.0075f, RobotLocation::get()->getRightEncoder().get(), rightMotors.get(), 0.05f);
-	syncController = new PIDController(0.01f, 0.00003f, 0.f, 0.f, RobotLocation::get()->getRightEncoder().get(), rightMotors.get(), 0.05f);
-	distanceController = new PIDController(0.01f, 0.00003f, 0.f, 0.f, RobotLocation::get()->getLeftEncoder().get(), leftMotors.get(), 0.05f);
+	MotionProfile &profile = profiles[slot];
+	if (!profile.generate(inches, std::abs(motorVelocity) * DriveConstants::MAX_VELOCITY, DriveConstants::MAX_ACCELERATION,
+	                      DriveConstants::MAX_JERK, DriveConstants::PROFILE_PERIOD))
+	{
+		Telemetry::get()->record(tooLongChannel, inches);
+		return;
+	}
 
+	//claim the slot before the move can reach the control thread and be popped
+	profileSlotsInUse.fetch_or(1u << slot);
+	enqueue(DriveAction::makeMove(inches, motorVelocity, slot));
 }
 
 void DriveAuto::axisTurn(float degrees)
 {
-	std::pair<DriveActions, std::vector<float>> moveAction;
-	moveAction.first = DriveActions::Turn;
-	std::vector<float> params;
-	params.push_back(degrees - TURN_SPEED * 100 * (degrees / 180));
-	moveAction.second = params;
-	actionQueue.push (moveAction); //Puts degrees and Turn into actionQueue
+	enqueue(DriveAction::makeTurn(degrees));
 }
 
 void DriveAuto::wait(float seconds)
 {
-	std::pair<DriveActions, std::vector<float>> moveAction;
-	moveAction.first = DriveActions::Wait;
-	std::vector<float> params;
-	params.push_back(seconds);
-	moveAction.second = params;
-	actionQueue.push (moveAction); //Stores seconds and Wait in actionQueue
+	enqueue(DriveAction::makeWait(seconds));
 }
 
-void DriveAuto::toteAlign()
+//the trajectory must outlive the action, which views from a TrajectoryCache do
+void DriveAuto::followTrajectory(const TrajectoryView *trajectory)
 {
-	std::pair<DriveActions, std::vector<float>> moveAction;
-	moveAction.first = DriveActions::ToteAlign;
-	std::vector<float> params;
-	moveAction.second = params;
+	if (trajectory == nullptr)
+	{
+		Telemetry::get()->record(missingPathChannel, 1);
+		return;
+	}
+	enqueue(DriveAction::makeTrajectory(trajectory));
+}
+
+//the path is relative to wherever the robot is when the action starts, and must outlive the action
+void DriveAuto::followPath(const PursuitPath *path)
+{
+	if (path == nullptr || path->count < 2)
+	{
+		Telemetry::get()->record(missingPathChannel, 0);
+		return;
+	}
+	enqueue(DriveAction::makePursuit(path));
+}
 
-	dsLeftController = new PIDController(0.0002f, 0.0f, 0.0f, 0.0075f, RobotLocation::get()->getLeftEncoder().get(), leftMotors.get(), 0.05f);
-	dsRightController = new PIDController(0.0002f, 0.0f, 0.0f, 0.0075f, RobotLocation::get()->getRightEncoder().get(), rightMotors.get(), 0.05f);
-	dsLeftController->Enable();
-	dsRightController->Enable();
+//drives both sides along the profiles the followers were started on, returns true when done
+bool DriveAuto::followProfiles(float leftStart, float rightStart)
+{
+	float elapsed = actionTimer.Get();
+	float leftTravel = leftDistance - leftStart;
+	float rightTravel = rightDistance - rightStart;
 
-	syncController = new PIDController(0.00009f, 0.0f, 0.0f, 0.0075f, RobotLocation::get()->getRightEncoder().get(), rightMotors.get(), 0.05f);
+	if(leftFollower.isFinished(elapsed, leftTravel) && rightFollower.isFinished(elapsed, rightTravel))
+	{
+		leftMotors->Set(0);
+		rightMotors->Set(0);
+		actionTimer.Stop();
+		return true;
+	}
 
-	distanceController = new PIDController(0.1f, 0.f, 0.f, 0.f, RobotLocation::get()->getLeftEncoder().get(), leftMotors.get(), 0.05f);
+	leftMotors->Set(leftFollower.calculate(elapsed, leftTravel));
+	rightMotors->Set(rightFollower.calculate(elapsed, rightTravel));
+	return false;
+}
 
-	std::queue<std::pair<DriveActions, std::vector<float>>> emptyQueue;
-	std::swap(actionQueue, emptyQueue);
-	actionQueue.push (moveAction);
+void DriveAuto::toteAlign()
+{
+	disableControllers();
+	dsLeftController->rearm(0.0002f, 0.0f, 0.0f, 0.0075f, 0.f);
+	dsRightController->rearm(0.0002f, 0.0f, 0.0f, 0.0075f, 0.f);
+	syncController->retune(0.00009f, 0.0f, 0.0f, 0.0075f);
+	distanceController->retune(0.1f, 0.f, 0.f, 0.f);
+
+	Command command;
+	command.clear = true;
+	command.hasAction = true;
+	command.action = DriveAction::makeToteAlign();
+	submit(command);
 }
 
 void DriveAuto::panic()
 {
-	std::queue<std::pair<DriveActions, std::vector<float>>> emptyQueue;
-	std::swap(actionQueue, emptyQueue);
+	disableControllers();
 
-	while (actionQueue.size() > 0)
-		actionQueue.pop();
+	Command command;
+	command.clear = true;
+	command.hasAction = false;
+	submit(command);
 }
 
 void DriveAuto::update()
 {
-	std::cout << "left  \t" << RobotLocation::get()->getLeftEncoder()->GetDistance() << std::endl;
-	std::cout << "right \t" << RobotLocation::get()->getRightEncoder()->GetDistance() << std::endl;
+	leftDistance = RobotLocation::get()->getLeftDistance()->get();
+	rightDistance = RobotLocation::get()->getRightDistance()->get();
+	TELEMETRY_VERBOSE_RECORD(encoderChannel, leftDistance, rightDistance);
 	//std::cout << "Current gyro value: " << RobotLocation::get()->getGyro()->GetAngle() << std::endl;
-	if (actionQueue.size() == 0)
+	RobotLocation::get()->updateOdometry(leftDistance, rightDistance);
+	if (actionQueue.empty())
 	{
 		return; //If there's nothing in the queue to do then return
 	}
 
-	std::pair<DriveAuto::DriveActions, std::vector<float> > &action = actionQueue.front();
+	DriveAction &action = actionQueue.front();
 	auto robotLocation = RobotLocation::get();
 
-	if(action.first == DriveAuto::DriveActions::Move)
+	if(action.type == DriveAction::Move)
 	{
 		if(initiallyStraight == true)
 		{
-
 			//initialAngle = RobotLocation::get()->getGyro()->GetAngle() * -1; //THIS DOES NOT WORK
 			//std::cout << initialAngle << std::endl;
 
 			initiallyStraight = false;
-			action.second[2] = RobotLocation::get()->getLeftEncoder()->GetDistance();
+			action.move.leftStart = leftDistance;
+			action.move.rightStart = rightDistance;
 
-			distanceController->Enable();
-			syncController->Enable();
-			distanceController->SetSetpoint(action.second[2] + action.second[0]);
-			syncController->SetSetpoint(RobotLocation::get()->getRightEncoder()->GetDistance() + action.second[0]);
-		}
-		else
-		{
-			//std::cout << "right dist" << RobotLocation::get()->getRightEncoder()->GetDistance() << std::endl;
-			//std::cout << leftMotors->Get() << "\t\t" << rightMotors->Get() << std::endl;
-			leftMotors->Set(action.second[1]);
-			rightMotors->Set(action.second[1]);
-			float totalDistance = robotLocation->getLeftEncoder()->GetDistance();
-			if(totalDistance - action.second[2] > action.second[0]) //if totalDistance is more or less 0
+			//moves and shallow turns queued behind this one become a single maneuver
+			blendedActions = blending ? blender.plan(actionQueue) : 0;
+			if (blendedActions > 1)
 			{
-				std::cout << "update called" << std::endl;
-				leftMotors->Set(0);
-				rightMotors->Set(0);
-				syncController->Disable();
-				distanceController->Disable();
-				delete syncController;
-				delete distanceController;
-				actionQueue.pop();
-				initiallyStraight = true;
-				if (actionQueue.size() > 0 && actionQueue.front().first == DriveAuto::DriveActions::Move) //If there's stuff in actionQueues
-				{
-					//std::cout << "nyan" << std::endl;
-					float leftDistance = robotLocation->getLeftEncoder()->GetDistance();
-					actionQueue.front().second[2] = leftDistance;
-				}
+				leftFollower.start(blender.getLeft(), blender.size(), blender.getPeriod());
+				rightFollower.start(blender.getRight(), blender.size(), blender.getPeriod());
 			}
+			else
+			{
+				blendedActions = 1;
+				leftFollower.start(&profiles[action.move.profileSlot]);
+				rightFollower.start(&profiles[action.move.profileSlot]);
+			}
+			actionTimer.Reset();
+			actionTimer.Start();
+		}
+
+		//each side follows the profile on its own, which also keeps the robot straight
+		if(followProfiles(action.move.leftStart, action.move.rightStart))
+		{
+			Telemetry::get()->record(moveDoneChannel, actionTimer.Get(), blendedActions);
+			for (int i = 0; i < blendedActions; i++)
+				popAction();
+			initiallyStraight = true;
+		}
+	}
+	else if(action.type == DriveAction::FollowTrajectory)
+	{
+		if(initiallyStraight == true)
+		{
+			initiallyStraight = false;
+			const TrajectoryView *trajectory = action.path.trajectory;
+			action.path.leftStart = leftDistance;
+			action.path.rightStart = rightDistance;
+			leftFollower.start(trajectory->left, trajectory->count, trajectory->period);
+			rightFollower.start(trajectory->right, trajectory->count, trajectory->period);
+			actionTimer.Reset();
+			actionTimer.Start();
+		}
+
+		if(followProfiles(action.path.leftStart, action.path.rightStart))
+		{
+			popAction();
+			initiallyStraight = true;
 		}
 	}
-	else if(action.first == DriveAuto::DriveActions::Turn)
+	else if(action.type == DriveAction::FollowPath)
 	{
+		if(initiallyStraight == true)
+		{
+			initiallyStraight = false;
+			action.pursuit.origin = robotLocation->getPose();
+			action.pursuit.lastTime = 0;
+			pursuit.start(action.pursuit.path);
+			actionTimer.Reset();
+			actionTimer.Start();
+		}
+
+		float now = actionTimer.Get();
+		Pose pose = relativePose(robotLocation->getPose(), action.pursuit.origin);
+		WheelSpeeds speeds = pursuit.calculate(pose, now - action.pursuit.lastTime);
+		action.pursuit.lastTime = now;
+
+		leftMotors->Set(speeds.left * DriveConstants::MOVE_KV);
+		rightMotors->Set(speeds.right * DriveConstants::MOVE_KV);
+
+		if(pursuit.isFinished())
+		{
+			actionTimer.Stop();
+			popAction();
+			initiallyStraight = true;
+		}
+	}
+	else if(action.type == DriveAction::Turn)
+	{
+		//the gyro reads counterclockwise, turns are positive to the right
+		float heading = RobotLocation::get()->getGyro()->GetAngle() * -1;
 		if(initialTurn == true)
 		{
-			std::cout << "axis turn enable" << std::endl;
-			RobotLocation::get()->getGyro()->Reset();
-			initialAngle = RobotLocation::get()->getGyro()->GetAngle() * -1;
-			std::cout << "Initial angle: " << initialAngle << std::endl;
-			wantedAngle = initialAngle + action.second[0];
-			std::cout << "Wanted angle: " << wantedAngle << std::endl;
 			initialTurn = false;
+			actionTimer.Reset();
+			actionTimer.Start();
+			turnController.start(heading, action.turn.degrees, 0);
 		}
-		else
+
+		float output = turnController.calculate(heading, actionTimer.Get());
+		leftMotors->Set(output);
+		rightMotors->Set(-output);
+
+		if(turnController.isFinished())
 		{
-			if(action.second[0] > 0) //want to turn right
+			const TurnReport &report = turnController.getReport();
 			{
-				std::cout << "axis turn start" << std::endl;
-				leftMotors->Set(TURN_SPEED);
-				rightMotors->Set(-TURN_SPEED);
-				if(RobotLocation::get()->getGyro()->GetAngle() * -1 > wantedAngle) //need to use tolerance here
-				{
-					std::cout << "turn GetAngle: " << RobotLocation::get()->getGyro()->GetAngle() << std::endl;
-					std::cout << "turn wanted angle: " << wantedAngle << std::endl;
-					std::cout << "Current gyro value: " << RobotLocation::get()->getGyro()->GetAngle() << std::endl;
-					leftMotors->Set(0);
-					rightMotors->Set(0);
-					std::cout << "axis turn done" <<std::endl;
-					actionQueue.pop();
-					initialTurn = true;
-					if (actionQueue.size() > 0 && actionQueue.front().first == DriveAuto::DriveActions::Move) //If there's stuff in actionQueues
-					{
-						float leftDistance = robotLocation->getLeftEncoder()->GetDistance();
-						actionQueue.front().second[2] = leftDistance;
-					}
-				}
-			}
-			if(action.second[0] < 0) //want to turn left
-			{
-				leftMotors->Set(-TURN_SPEED);
-				rightMotors->Set(TURN_SPEED);
-				if(RobotLocation::get()->getGyro()->GetAngle() * -1 < wantedAngle) //need to use tolerance here
-				{
-					leftMotors->Set(0);
-					rightMotors->Set(0);
-					actionQueue.pop();
-					initialTurn = true;
-					if (actionQueue.size() > 0 && actionQueue.front().first == DriveAuto::DriveActions::Move) //If there's stuff in actionQueues
-					{
-						float leftDistance = robotLocation->getLeftEncoder()->GetDistance();
-						actionQueue.front().second[2] = leftDistance;
-					}
-				}
+				std::lock_guard<std::mutex> lock(reportMutex);
+				lastTurnReport = report;
 			}
+			Telemetry::get()->record(turnDoneChannel, report.target, report.seconds, report.finalError, report.timedOut);
+			leftMotors->Set(0);
+			rightMotors->Set(0);
+			actionTimer.Stop();
+			popAction();
+			initialTurn = true;
 		}
 	}
-	else if(action.first == DriveAuto::DriveActions::Wait)
+	else if(action.type == DriveAction::Wait)
 	{
 		if (waitTimer.Get() == 0)
 			waitTimer.Start();
@@ -244,39 +475,24 @@ void DriveAuto::update()
 		{
 			leftMotors->Set(0);
 			rightMotors->Set(0);
-			if (waitTimer.Get() > action.second[0])
+			if (waitTimer.Get() > action.wait.seconds)
 			{
-				actionQueue.pop();
+				popAction();
 				waitTimer.Reset();
 			}
 
 		}
 	}
-	/*else if(action.first == DriveAuto::DriveActions::ToteAlign)
+	/*else if(action.type == DriveAction::ToteAlign)
 	{
 		auto *rl = RobotLocation::get();
 
 		if (!tolerance(computedMA, DISTANCE_DS, 2))
 		{
-			const int MA_LENGTH = 12;
 			double dist = rl->getEast()->getDistance();
 
-			movingAverage.push_front(dist);
-			if (movingAverage.size() > MA_LENGTH) movingAverage.pop_back();
-
-			int max = 0, min = 999999;
-			std::for_each (movingAverage.begin(), movingAverage.end(),	//identify outliers
-				[&] (auto e) {
-					if (e > max) max = e; else if (e < min) min = e;
-				}
-			);
-
-			auto copy = movingAverage;
-			copy.remove_if([&] (auto e) { return e <= min || e >= max; });
-
-			computedMA = 0;
-			for (auto e : copy) { computedMA += e; }
-			computedMA /= copy.size();
+			movingAverage.giveRawValue(dist);
+			computedMA = movingAverage.computeAverage();
 
 			double diff = DISTANCE_DS - computedMA;
 
@@ -306,12 +522,8 @@ void DriveAuto::update()
 
 			if (rl->getNorth()->getDistance() <= DISTANCE_TS)
 			{
-				actionQueue.pop();
-				distanceController->Disable();
-				delete dsLeftController;
-				delete dsRightController;
-				delete syncController;
-				delete distanceController;
+				popAction();
+				disableControllers();
 			}
 		}
 	}*/
@@ -3,9 +3,24 @@
 
 #include <iostream>
 #include <WPILib.h>
-#include <queue>
+#include "ActionQueue.hpp"
+#include "DriveAction.hpp"
+#include "ReusablePIDController.hpp"
+#include "MotionProfile.hpp"
+#include "ProfileFollower.hpp"
+#include "Trajectory.hpp"
+#include "SpscQueue.hpp"
+#include "ControlThread.hpp"
+#include "HeadingController.hpp"
+#include "PurePursuit.hpp"
+#include "ActionBlender.hpp"
+#include "Telemetry.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include "TwoMotorGroup.hpp"
 #include "RobotLocation.hpp"
+#include "TrimmedMean.hpp"
 
 class DriveAuto
 {
@@ -13,43 +28,102 @@ public:
 	void move(float inches, float motorVelocity);
 	void axisTurn(float degrees);
 	void wait(float seconds);
+	void followTrajectory(const TrajectoryView *trajectory);
+	void followPath(const PursuitPath *path);
 	void toteAlign();
 	void panic();
-	enum DriveActions
-	{
-		Move,
-		Turn,
-		Wait,
-		ToteAlign
-	};
 	void update();
+	std::size_t getQueueDepth() const;
+	std::size_t getQueueHighWaterMark() const;
+	static int getLiveControllerCount();
+	TurnReport getLastTurnReport() const; //target, final error and time of the last axis turn
+	void setBlending(bool enabled);        //join queued moves and shallow turns without stopping, on by default
+
+	//opt-in: run update() on a dedicated thread instead of from AutonomousPeriodic
+	bool startControlThread(double hz);
+	void stopControlThread();
+	bool isThreaded() const;
+	ControlThread::Stats getControlStats() const;
+
 	static DriveAuto* get();
 	const std::shared_ptr<TwoMotorGroup> getLeftMotors();
 	const std::shared_ptr<TwoMotorGroup> getRightMotors();
 
 private:
 	DriveAuto();
-	std::queue<std::pair <DriveActions, std::vector<float>>> actionQueue;
+	struct Command
+	{
+		bool clear;          //drop everything queued before adding action
+		bool hasAction;
+		DriveAction action;
+	};
+
+	void submit(const Command& command);
+	void apply(const Command& command);
+	void controlStep();
+	void publishStatus();
+	void enqueue(const DriveAction& action);
+	void popAction();
+	void clearActions();
+	void releaseProfile(const DriveAction& action);
+	void disableControllers();
+	bool followProfiles(float leftStart, float rightStart);
+
+	static const std::size_t ACTION_QUEUE_CAPACITY = 32;
+	ActionQueue<DriveAction, ACTION_QUEUE_CAPACITY> actionQueue;
 	const std::shared_ptr<TwoMotorGroup> leftMotors;
 	const std::shared_ptr<TwoMotorGroup> rightMotors;
 	static DriveAuto* instance;
 	float initialAngle;
-	float wantedAngle;
 	bool initiallyStraight;
 	bool initialAlign;
 	bool initialTurn;
 
-	std::list<double> movingAverage;
+	TrimmedMean<double> movingAverage; //east distance for ToteAlign, trimmed of the closest and farthest reading
 	double computedMA;
 
 	bool initialAlignDistance;
-	const float TURN_SPEED;
-	PIDController* dsLeftController;
-	PIDController* dsRightController;
-	PIDController* syncController;
-	PIDController* distanceController;
+	const std::unique_ptr<ReusablePIDController> dsLeftController;
+	const std::unique_ptr<ReusablePIDController> dsRightController;
+	const std::unique_ptr<ReusablePIDController> syncController;
+	const std::unique_ptr<ReusablePIDController> distanceController;
 
 	Timer waitTimer;
+
+	//moves are profiled when queued and own their slot until they leave the queue or fail to join it;
+	//only move() sets bits and only releaseProfile() clears them
+	static const int PROFILE_SLOTS = 8;
+	std::array<MotionProfile, PROFILE_SLOTS> profiles;
+	std::atomic<uint32_t> profileSlotsInUse;
+	ProfileFollower leftFollower;
+	ProfileFollower rightFollower;
+	Timer actionTimer;
+	HeadingController turnController;
+	TurnReport lastTurnReport;
+	PurePursuit pursuit;
+	ActionBlender blender;
+	std::atomic<bool> blending;
+	int blendedActions;  //queue entries the running move covers, 1 when it isn't blended
+	float leftDistance;  //this cycle's sampled encoder distances, read once so odometry and the followers agree
+	float rightDistance;
+
+	//update() can run on the control thread, so it reports through Telemetry instead of std::cout
+	const Telemetry::Channel encoderChannel;
+	const Telemetry::Channel moveDoneChannel;
+	const Telemetry::Channel turnDoneChannel;
+	const Telemetry::Channel commandFullChannel;
+	const Telemetry::Channel actionFullChannel;
+	const Telemetry::Channel noProfileChannel;
+	const Telemetry::Channel tooLongChannel;
+	const Telemetry::Channel missingPathChannel;
+	mutable std::mutex reportMutex;
+
+	//commands from the robot thread to the control thread when threaded
+	SpscQueue<Command, 64> commands;
+	std::unique_ptr<ControlThread> controlThread;
+	std::atomic<bool> threaded;
+	std::atomic<std::size_t> queueDepth;
+	std::atomic<std::size_t> queueHighWaterMark;
 };
 
 #endif
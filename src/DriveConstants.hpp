@@ -0,0 +1,61 @@
+#ifndef DRIVE_CONSTANTS_HPP
+#define DRIVE_CONSTANTS_HPP
+
+//Drivetrain characteristics shared by DriveAuto and its simulation tests.
+//Distances are in inches, as reported by the drive encoders.
+namespace DriveConstants
+{
+	const float MAX_VELOCITY = 120.f;      //inches per second at full output in low gear
+	const float MAX_ACCELERATION = 150.f;  //inches per second^2, keeps the robot from tipping
+	const float MAX_JERK = 1500.f;         //inches per second^3, softens the start and end of a move
+	const float MOTOR_TIME_CONSTANT = 0.3f; //seconds for the drivetrain to reach 63% of a new speed
+	const float TRACK_WIDTH = 25.f;        //inches between the left and right wheels
+
+	const float PROFILE_PERIOD = 0.01f;    //seconds between motion profile samples
+
+	const float MOVE_KV = 1.f / MAX_VELOCITY;
+	const float MOVE_KA = MOTOR_TIME_CONSTANT / MAX_VELOCITY;
+	const float MOVE_KP = 0.08f;
+	const float MOVE_KD = 0.004f;
+	const float MOVE_TOLERANCE = 0.5f;     //inches
+	const float MOVE_TIMEOUT = 1.f;        //seconds allowed past the end of the profile
+
+	//turns, in degrees with positive to the right
+	const float TURN_MAX_RATE = 270.f;     //degrees per second
+	const float TURN_MAX_ACCELERATION = 720.f;
+	const float TURN_KV = 1.f / 550.f;     //output per degree per second, both sides driven at output turns ~550 deg/s
+	const float TURN_KP = 0.04f;
+	const float TURN_KD = 0.002f;
+	const float TURN_MIN_OUTPUT = 0.08f;   //overcomes wheel scrub when the error is outside tolerance
+	const float TURN_TOLERANCE = 1.5f;     //degrees
+	const float TURN_SETTLE_TIME = 0.1f;   //seconds the heading must stay in tolerance
+	const float TURN_TIMEOUT = 1.5f;       //seconds allowed past the end of the profiled setpoint
+
+	//pure pursuit, drives through curves without stopping
+	const float PURSUIT_LOOKAHEAD = 18.f;  //inches, shorter tracks tighter but oscillates
+	const float PURSUIT_MAX_VELOCITY = 0.8f * MAX_VELOCITY; //leaves the outside wheel room to speed up
+	const float PURSUIT_MAX_ACCELERATION = MAX_ACCELERATION;
+	const float PURSUIT_TOLERANCE = 1.f;   //inches from the last point
+	const float PURSUIT_SPACING = 2.f;     //inches between path points
+
+	//blending queued moves and shallow turns into arcs
+	const float BLEND_MAX_TURN = 60.f;     //degrees, sharper turns still stop and turn in place
+	const float BLEND_RADIUS = 30.f;       //inches, largest arc radius used at a corner
+
+	//teleop stick shaping, per driver station packet (50 Hz)
+	const float DRIVE_AXIS_DEADBAND = 0.1f;
+	const float DRIVE_AXIS_EXPO = 0.2f;
+	const float DRIVE_AXIS_SLEW = 0.25f;   //output per packet, full stick in 80 ms without lurching
+	const float TWIST_AXIS_DEADBAND = 0.1f;
+	const float TWIST_AXIS_EXPO = 0.4f;    //finer control near center for lining up on totes
+	const float TWIST_AXIS_SMOOTHING = 0.6f; //one pole alpha, settles within 5% in 4 packets
+
+	//sensor smoothing in RobotLocation::filterSensors(), once per driver station packet
+	const float SENSOR_RATE = 50.f;        //Hz
+	const int RATE_AVERAGE_SAMPLES = 3;    //encoder rates step as pulses land in the counting window
+	const float RATE_CUTOFF = 8.f;         //Hz, Butterworth low pass after the average
+	const float SAMPLER_RATE = 200.f;      //Hz, RobotLocation's sensor sampler thread
+	const float ENCODER_SAMPLE_RATE = 200.f; //Hz, encoder distances read for the PID loops
+}
+
+#endif
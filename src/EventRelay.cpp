@@ -1,104 +1,181 @@
 #include "EventRelay.hpp"
 #include "ActionMap.hpp"
 #include "DriveAuto.hpp"
+#include "LatencyTracer.hpp"
+#include "DriveConstants.hpp"
+
+//how close the filtered drive command must get to the stick before the input counts as delivered
+const double DRIVE_LATENCY_TOLERANCE = 0.05;
 
 EventRelay::EventRelay()
-	: actionMapJoy()
-	, actionMapGCN()
-	, joyWrap(0)
-	, gamecube(1)
-	, movingAverageDrive(25)
-	, movingAverageTwist(25)
+	: bus(nullptr)
+	, active(new InputBus())
+	, retired()
+	, devices()
+	, driveFilter(ScaledDeadband(DriveConstants::DRIVE_AXIS_DEADBAND)
+				, Expo(DriveConstants::DRIVE_AXIS_EXPO)
+				, SlewLimiter(DriveConstants::DRIVE_AXIS_SLEW))
+	, twistFilter(ScaledDeadband(DriveConstants::TWIST_AXIS_DEADBAND)
+				, Expo(DriveConstants::TWIST_AXIS_EXPO)
+				, OnePole(DriveConstants::TWIST_AXIS_SMOOTHING))
+	, onlyFB_GCN(false)
+	, lastDriveInput(0)
+	, loopTime(Timer::GetFPGATimestamp())
+	, zeroMotorsAt(loopTime)
+	, recorder(nullptr)
+	, player(nullptr)
+	, replayStart(0)
+	, replayFrame()
 	, driveRobot(DriveAuto::get()->getLeftMotors()->getTalonOne().get()
 			   , DriveAuto::get()->getLeftMotors()->getTalonTwo().get()
 			   , DriveAuto::get()->getRightMotors()->getTalonOne().get()
 			   , DriveAuto::get()->getRightMotors()->getTalonTwo().get())
 {
 	std::cout << "Yeeeee... That Event Relay online" << std::endl;
+	bus.store(active.get());
+	attach(JOYSTICK_PORT);
+	attach(GAMECUBE_PORT);
+
 	driveRobot.SetInvertedMotor(static_cast<RobotDrive::MotorType>(0), false);
 	driveRobot.SetInvertedMotor(static_cast<RobotDrive::MotorType>(1), false);
 	driveRobot.SetInvertedMotor(static_cast<RobotDrive::MotorType>(2), false);
 	driveRobot.SetInvertedMotor(static_cast<RobotDrive::MotorType>(3), false);
 
-	zeroMotorTimer.Start();
-
 	driveRobot.SetSafetyEnabled(false);
 }
 
-void EventRelay::checkStates()
+void EventRelay::checkStates(double now)
 {
-	auto *joyExtreme = joyWrap.getJoystick();
-	auto *gcn = gamecube.getJoystick();
+	loopTime = now;
+	pollDevices(now);
 
-	double driveAxis = joyExtreme->GetRawAxis(1);
-	double twistAxis = joyExtreme->GetRawAxis(2);
+	const JoystickWrapper &joyExtreme = *devices[JOYSTICK_PORT];
+	const JoystickWrapper &gcn = *devices[GAMECUBE_PORT];
 
-	driveAxis = std::abs(driveAxis) > 0.1 ? driveAxis : 0;
-	twistAxis = std::abs(twistAxis) > 0.1 ? twistAxis : 0;
+	float rawDrive = joyExtreme.getAxis(1);
+	float rawTwist = joyExtreme.getAxis(2);
 
-	//std::cout << gcn->GetRawAxis(1) << "\t\t" << gcn->GetRawAxis(0) << std::endl;
+	//what the drive command will settle to, the tag is answered once the filtered output gets there
+	float driveTarget = driveFilter.settle(rawDrive);
+	if (std::abs(driveTarget - lastDriveInput) > DRIVE_LATENCY_TOLERANCE)
+		LatencyTracer::get()->tag(LatencyPath::Drive, driveTarget, DRIVE_LATENCY_TOLERANCE);
+	lastDriveInput = driveTarget;
 
-	movingAverageDrive.giveRawValue(driveAxis);
-	movingAverageTwist.giveRawValue(twistAxis);
+	//std::cout << gcn.getAxis(1) << "\t\t" << gcn.getAxis(0) << std::endl;
 
-	driveAxis = movingAverageDrive.computeAverage();
-	twistAxis = movingAverageTwist.computeAverage();
+	float driveAxis = driveFilter(rawDrive);
+	float twistAxis = twistFilter(rawTwist);
 
-	float turnAxisGCN = onlyFB_GCN ? 0 : gcn->GetRawAxis(0);
+	float turnAxisGCN = onlyFB_GCN ? 0 : gcn.getAxis(0);
 	onlyFB_GCN = false;
 
 	//std::cout << "drive" << driveAxis << " twist" << twistAxis << std::endl;
 
-	if (zeroMotorTimer.Get() < 5)
+	if (now - zeroMotorsAt < 5)
 	{
 		DriveAuto::get()->getLeftMotors()->Set(0);
 		DriveAuto::get()->getRightMotors()->Set(0);
 	}
 	else
 	{
-		if (std::abs(gcn->GetRawAxis(1)) > 0.25 || std::abs(turnAxisGCN) > 0.25)
+		if (std::abs(gcn.getAxis(1)) > 0.25 || std::abs(turnAxisGCN) > 0.25)
 		{
-			driveRobot.ArcadeDrive(gcn->GetRawAxis(1) * 0.8, turnAxisGCN * .82);
+			driveRobot.ArcadeDrive(gcn.getAxis(1) * 0.8, turnAxisGCN * .82);
 		}
 		else
 		{
 			driveRobot.ArcadeDrive(driveAxis * 1, twistAxis * 1);
+			LatencyTracer::get()->issued(LatencyPath::Drive, driveAxis, Timer::GetFPGATimestamp());
 		}
 
 	}
 
-	joyWrap.pollJoystick();
-	gamecube.pollJoystick();
+	InputBus &bindings = *bus.load(std::memory_order_acquire);
+	bindings.beginFrame();
+	for (int port = 0; port < InputBus::MAX_DEVICES; port++)
+	{
+		if (devices[port])
+			bindings.publish(port, devices[port]->getEdges());
+	}
+	bindings.dispatch(now);
+}
 
-	std::array<JoyButton, 12> buttonStatesJoy = joyWrap.getStates();
-	std::array<JoyButton, 12> buttonStatesGCN = gamecube.getStates();
+//reads every attached stick, or the replay in place of them, and records what was read
+void EventRelay::pollDevices(double now)
+{
+	if (player)
+	{
+		//holds the last frame until the next is due, then sticks go neutral once the replay runs out
+		if (!player->advance(now - replayStart, replayFrame) && player->finished())
+			replayFrame = InputFrame();
+	}
 
-	for(unsigned int i = 0; i < buttonStatesJoy.size(); i++)
+	InputFrame frame;
+	frame.time = now;
+	for (int port = 0; port < InputBus::MAX_DEVICES; port++)
 	{
-		if (buttonStatesJoy[i].down || buttonStatesJoy[i].pressed || buttonStatesJoy[i].up)
-		{
-			actionMapJoy.eventOccurredFor(buttonStatesJoy[i]);
-		}
+		if (!devices[port])
+			continue;
+		if (player)
+			devices[port]->pollJoystick(replayFrame.devices[port]);
+		else
+			devices[port]->pollJoystick();
+		frame.devices[port] = devices[port]->getSample();
 	}
 
-	for(unsigned int i = 0; i < buttonStatesGCN.size(); i++)
+	if (recorder)
+		recorder->record(frame);
+}
+
+void EventRelay::record(InputRecorder *recorder)
+{
+	this->recorder = recorder;
+}
+
+void EventRelay::replay(InputPlayer *player, double now)
+{
+	this->player = player;
+	replayStart = now;
+	replayFrame = InputFrame();
+}
+
+uint8_t EventRelay::getAttached() const
+{
+	uint8_t attached = 0;
+	for (int port = 0; port < InputBus::MAX_DEVICES; port++)
 	{
-		if (buttonStatesGCN[i].down || buttonStatesGCN[i].pressed || buttonStatesGCN[i].up)
-		{
-			actionMapGCN.eventOccurredFor(buttonStatesGCN[i]);
-		}
+		if (devices[port])
+			attached |= 1 << port;
 	}
+	return attached;
 }
 
+void EventRelay::attach(int port)
+{
+	if (port < 0 || port >= InputBus::MAX_DEVICES || devices[port])
+		return;
+	devices[port].reset(new JoystickWrapper(port));
+}
 
-ActionMap& EventRelay::getMapJoy()
+InputBus& EventRelay::getBus()
 {
-	return actionMapJoy;
+	return *bus.load(std::memory_order_acquire);
 }
 
-ActionMap& EventRelay::getMapGCN()
+void EventRelay::setBindings(std::unique_ptr<InputBus> bindings)
 {
-	return actionMapGCN;
+	if (!bindings)
+		return;
+
+	for (int port = 0; port < InputBus::MAX_DEVICES; port++)
+	{
+		if (!bindings->getMap(port).empty())
+			attach(port);
+	}
+
+	retired = std::move(active);
+	active = std::move(bindings);
+	bus.store(active.get(), std::memory_order_release);
 }
 
 void EventRelay::setFBGCN()
@@ -108,5 +185,5 @@ void EventRelay::setFBGCN()
 
 void EventRelay::zeroMotors()
 {
-	zeroMotorTimer.Reset();
+	zeroMotorsAt = loopTime;
 }
@@ -2,28 +2,52 @@
 #define EVENT_RELAY_HPP
 
 #include <WPILib.h>
-#include "ActionMap.hpp"
+#include "InputBus.hpp"
 #include "JoystickWrapper.hpp"
-#include "MovingAverage.hpp"
+#include "InputRecording.hpp"
+#include "AxisFilter.hpp"
 #include <iostream>
+#include <array>
+#include <memory>
+#include <atomic>
+
+typedef AxisFilter<ScaledDeadband, Expo, SlewLimiter> DriveAxisFilter;
+typedef AxisFilter<ScaledDeadband, Expo, OnePole> TwistAxisFilter;
 
 class EventRelay
 {
 private:
-	ActionMap actionMapJoy;
-	ActionMap actionMapGCN;
-	JoystickWrapper joyWrap;
-	JoystickWrapper gamecube;
-	MovingAverage<double> movingAverageDrive;
-	MovingAverage<double> movingAverageTwist;
+	std::atomic<InputBus*> bus;      //bindings checkStates() dispatches through, swapped whole by setBindings()
+	std::unique_ptr<InputBus> active;
+	std::unique_ptr<InputBus> retired; //the table before the last swap, kept alive in case a loop is still using it
+	std::array<std::unique_ptr<JoystickWrapper>, InputBus::MAX_DEVICES> devices; //indexed by port, empty when not attached
+	DriveAxisFilter driveFilter;
+	TwistAxisFilter twistFilter;
 
 	bool onlyFB_GCN;
-	Timer zeroMotorTimer;
+	float lastDriveInput; //shaped drive target from the last packet, to spot new stick input for latency tracing
+	double loopTime;     //timestamp of the loop being handled
+	double zeroMotorsAt; //motors are held at zero for 5 seconds from here
+
+	InputRecorder *recorder; //null when not recording
+	InputPlayer *player;     //replays in place of the sticks when set
+	double replayStart;
+	InputFrame replayFrame;
+
+	void pollDevices(double now);
 
 public:
-	void checkStates();
-	ActionMap& getMapJoy();
-	ActionMap& getMapGCN();
+	static const int JOYSTICK_PORT = 0;
+	static const int GAMECUBE_PORT = 1;
+
+	void checkStates(double now); //now is the loop's timestamp, shared by everything timed in it
+	void attach(int port); //starts polling another driver station device
+	InputBus& getBus();
+	void setBindings(std::unique_ptr<InputBus> bindings); //attaches the devices it uses, then swaps it in
+	uint8_t getAttached() const; //bit per attached port
+
+	void record(InputRecorder *recorder); //every loop's stick state goes to recorder, null stops
+	void replay(InputPlayer *player, double now); //player's frames stand in for the sticks from now on, null stops
 
 	void setFBGCN();
 	void zeroMotors();
@@ -0,0 +1,194 @@
+#include "FilterBank.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+const int FilterBank::LANES;
+
+namespace
+{
+	const int B0 = 0, B1 = 1, B2 = 2, A1 = 3, A2 = 4, COEFFICIENTS = 5;
+	const int Z1 = 0, Z2 = 1, STATES = 2;
+
+	//four channels at a time in whatever registers the target has
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+	typedef float32x4_t Lanes;
+	const char* const KERNEL = "neon";
+
+	inline Lanes load(const float *p) { return vld1q_f32(p); }
+	inline void store(float *p, Lanes v) { vst1q_f32(p, v); }
+	inline Lanes zero() { return vdupq_n_f32(0); }
+	inline Lanes add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+	inline Lanes sub(Lanes a, Lanes b) { return vsubq_f32(a, b); }
+	inline Lanes mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+	inline Lanes multiplyAdd(Lanes sum, Lanes a, Lanes b) { return vmlaq_f32(sum, a, b); }
+#elif defined(__SSE__) || defined(_M_X64)
+	typedef __m128 Lanes;
+	const char* const KERNEL = "sse";
+
+	inline Lanes load(const float *p) { return _mm_loadu_ps(p); }
+	inline void store(float *p, Lanes v) { _mm_storeu_ps(p, v); }
+	inline Lanes zero() { return _mm_setzero_ps(); }
+	inline Lanes add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+	inline Lanes sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+	inline Lanes mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+	inline Lanes multiplyAdd(Lanes sum, Lanes a, Lanes b) { return _mm_add_ps(sum, _mm_mul_ps(a, b)); }
+#else
+	struct Lanes
+	{
+		float v[FilterBank::LANES];
+	};
+	const char* const KERNEL = "scalar";
+
+	inline Lanes load(const float *p)
+	{
+		Lanes l;
+		std::copy(p, p + FilterBank::LANES, l.v);
+		return l;
+	}
+	inline void store(float *p, const Lanes &l) { std::copy(l.v, l.v + FilterBank::LANES, p); }
+	inline Lanes zero() { return Lanes(); }
+
+	template <typename Op>
+	inline Lanes each(const Lanes &a, const Lanes &b, Op op)
+	{
+		Lanes l;
+		for (int i = 0; i < FilterBank::LANES; i++)
+			l.v[i] = op(a.v[i], b.v[i]);
+		return l;
+	}
+	inline Lanes add(const Lanes &a, const Lanes &b) { return each(a, b, [](float x, float y) { return x + y; }); }
+	inline Lanes sub(const Lanes &a, const Lanes &b) { return each(a, b, [](float x, float y) { return x - y; }); }
+	inline Lanes mul(const Lanes &a, const Lanes &b) { return each(a, b, [](float x, float y) { return x * y; }); }
+	inline Lanes multiplyAdd(const Lanes &sum, const Lanes &a, const Lanes &b) { return add(sum, mul(a, b)); }
+#endif
+}
+
+Biquad Biquad::identity()
+{
+	Biquad biquad = { 1, 0, 0, 0, 0 };
+	return biquad;
+}
+
+//from the Audio EQ Cookbook
+Biquad Biquad::lowPass(double cutoff, double sampleRate, double q)
+{
+	double w0 = 2 * M_PI * cutoff / sampleRate;
+	double alpha = std::sin(w0) / (2 * q);
+	double cosw0 = std::cos(w0);
+	double a0 = 1 + alpha;
+
+	Biquad biquad;
+	biquad.b0 = static_cast<float>((1 - cosw0) / 2 / a0);
+	biquad.b1 = static_cast<float>((1 - cosw0) / a0);
+	biquad.b2 = biquad.b0;
+	biquad.a1 = static_cast<float>(-2 * cosw0 / a0);
+	biquad.a2 = static_cast<float>((1 - alpha) / a0);
+	return biquad;
+}
+
+FilterBank::FilterBank(int channels, int taps, int sections)
+	: channels(channels)
+	, stride((channels + LANES - 1) / LANES * LANES)
+	, taps(std::max(taps, 1))
+	, sections(std::max(sections, 0))
+	, head(0)
+	, inputs(stride)
+	, outputs(stride)
+	, firCoefficients(this->taps * stride)
+	, firHistory(2 * this->taps * stride)
+	, biquadCoefficients(this->sections * COEFFICIENTS * stride)
+	, biquadState(this->sections * STATES * stride)
+{
+	for (int channel = 0; channel < stride; channel++)
+	{
+		firCoefficients[channel] = 1;
+		for (int section = 0; section < this->sections; section++)
+			setBiquad(channel, section, Biquad::identity());
+	}
+}
+
+void FilterBank::setFir(int channel, const float *coefficients, int count)
+{
+	for (int tap = 0; tap < taps; tap++)
+		firCoefficients[tap * stride + channel] = tap < count ? coefficients[tap] : 0;
+}
+
+void FilterBank::setMovingAverage(int channel, int length)
+{
+	length = std::min(std::max(length, 1), taps);
+	std::vector<float> coefficients(length, 1.f / length);
+	setFir(channel, coefficients.data(), length);
+}
+
+void FilterBank::setBiquad(int channel, int section, const Biquad &biquad)
+{
+	float *c = &biquadCoefficients[section * COEFFICIENTS * stride + channel];
+	c[B0 * stride] = biquad.b0;
+	c[B1 * stride] = biquad.b1;
+	c[B2 * stride] = biquad.b2;
+	c[A1 * stride] = biquad.a1;
+	c[A2 * stride] = biquad.a2;
+}
+
+void FilterBank::step()
+{
+	//the window for this sample is rows head + 1 to head + taps, oldest first
+	const float *window = &firHistory[(head + 1) * stride];
+
+	for (int block = 0; block < stride; block += LANES)
+	{
+		Lanes x = load(&inputs[block]);
+		store(&firHistory[head * stride + block], x);
+		store(&firHistory[(head + taps) * stride + block], x);
+
+		Lanes y = zero();
+		for (int tap = 0; tap < taps; tap++)
+			y = multiplyAdd(y, load(&firCoefficients[tap * stride + block]), load(&window[(taps - 1 - tap) * stride + block]));
+
+		//transposed direct form II, two states per section
+		for (int section = 0; section < sections; section++)
+		{
+			const float *c = &biquadCoefficients[section * COEFFICIENTS * stride + block];
+			float *z = &biquadState[section * STATES * stride + block];
+			Lanes in = y;
+			Lanes z1 = load(&z[Z1 * stride]);
+			Lanes z2 = load(&z[Z2 * stride]);
+
+			y = multiplyAdd(z1, load(&c[B0 * stride]), in);
+			z1 = sub(multiplyAdd(z2, load(&c[B1 * stride]), in), mul(load(&c[A1 * stride]), y));
+			z2 = sub(mul(load(&c[B2 * stride]), in), mul(load(&c[A2 * stride]), y));
+
+			store(&z[Z1 * stride], z1);
+			store(&z[Z2 * stride], z2);
+		}
+
+		store(&outputs[block], y);
+	}
+
+	head = head + 1 == taps ? 0 : head + 1;
+}
+
+void FilterBank::reset()
+{
+	std::fill(inputs.begin(), inputs.end(), 0);
+	std::fill(outputs.begin(), outputs.end(), 0);
+	std::fill(firHistory.begin(), firHistory.end(), 0);
+	std::fill(biquadState.begin(), biquadState.end(), 0);
+	head = 0;
+}
+
+int FilterBank::getChannels() const
+{
+	return channels;
+}
+
+const char* FilterBank::kernel()
+{
+	return KERNEL;
+}
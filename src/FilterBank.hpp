@@ -0,0 +1,67 @@
+#ifndef FILTER_BANK_HPP
+#define FILTER_BANK_HPP
+
+#include <vector>
+
+//one second order section, y = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2) x
+struct Biquad
+{
+	float b0, b1, b2;
+	float a1, a2;
+
+	static Biquad identity();
+	static Biquad lowPass(double cutoff, double sampleRate, double q = 0.70710678); //Butterworth at the default q
+};
+
+/**
+ * Filters many sensor streams together, one sample per channel per step().
+ * Every channel runs the same shape of filter, an FIR of taps followed by a
+ * cascade of biquad sections, with its own coefficients. State and coefficients
+ * are kept structure-of-arrays, channel fastest, so step() walks memory once and
+ * works on four channels per instruction with NEON or SSE, or plain floats when
+ * neither is available. Channels are padded up to a multiple of four.
+ * Channels start as pass-through; shorter filters just leave the rest identity.
+ */
+class FilterBank
+{
+public:
+	static const int LANES = 4;
+
+	FilterBank(int channels, int taps, int sections);
+
+	void setFir(int channel, const float *coefficients, int count); //coefficients[0] weighs the newest sample
+	void setMovingAverage(int channel, int length);
+	void setBiquad(int channel, int section, const Biquad &biquad);
+
+	void input(int channel, float value)
+	{
+		inputs[channel] = value;
+	}
+
+	float output(int channel) const
+	{
+		return outputs[channel];
+	}
+
+	void step(); //advances every channel by the sample last given to input()
+	void reset();
+
+	int getChannels() const;
+	static const char* kernel(); //"neon", "sse" or "scalar"
+
+private:
+	int channels;
+	int stride; //channels rounded up to LANES
+	int taps;
+	int sections;
+	int head;
+
+	std::vector<float> inputs;
+	std::vector<float> outputs;
+	std::vector<float> firCoefficients; //[tap][channel]
+	std::vector<float> firHistory;      //[2 * taps][channel], each sample is written twice so a window is never split
+	std::vector<float> biquadCoefficients; //[section][b0 b1 b2 a1 a2][channel]
+	std::vector<float> biquadState;        //[section][z1 z2][channel]
+};
+
+#endif
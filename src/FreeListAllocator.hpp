@@ -0,0 +1,133 @@
+#ifndef FREE_LIST_ALLOCATOR_HPP
+#define FREE_LIST_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * Fixed pool of equal sized blocks handed out from a free list.
+ * The block size is taken from the first allocation, so a node based container
+ * can share one arena without knowing its node type. Once the pool runs out,
+ * allocations fall back to the heap.
+ */
+class FreeListArena
+{
+public:
+	explicit FreeListArena(std::size_t blocks)
+		: capacity(blocks)
+		, blockSize(0)
+		, freeList(nullptr)
+	{
+	}
+
+	void* allocate(std::size_t bytes)
+	{
+		if (blockSize == 0)
+			carve(bytes);
+		if (bytes > blockSize || freeList == nullptr)
+			return ::operator new(bytes);
+
+		Block *block = freeList;
+		freeList = block->next;
+		return block;
+	}
+
+	void deallocate(void *pointer)
+	{
+		if (!owns(pointer))
+		{
+			::operator delete(pointer);
+			return;
+		}
+
+		Block *block = static_cast<Block*>(pointer);
+		block->next = freeList;
+		freeList = block;
+	}
+
+private:
+	union Block
+	{
+		Block *next;
+		std::max_align_t align;
+	};
+
+	void carve(std::size_t bytes)
+	{
+		blockSize = (bytes + sizeof(Block) - 1) / sizeof(Block) * sizeof(Block);
+		std::size_t perBlock = blockSize / sizeof(Block);
+		storage.resize(capacity * perBlock);
+		for (std::size_t i = capacity; i-- > 0;)
+		{
+			Block *block = &storage[i * perBlock];
+			block->next = freeList;
+			freeList = block;
+		}
+	}
+
+	bool owns(void *pointer) const
+	{
+		const Block *block = static_cast<const Block*>(pointer);
+		return !storage.empty() && block >= &storage.front() && block <= &storage.back();
+	}
+
+	FreeListArena(const FreeListArena&);
+	FreeListArena& operator=(const FreeListArena&);
+
+	std::size_t capacity;
+	std::size_t blockSize;
+	Block *freeList;
+	std::vector<Block> storage;
+};
+
+//standard allocator over a FreeListArena, for node based containers that allocate one node at a time
+template <typename T>
+class FreeListAllocator
+{
+public:
+	typedef T value_type;
+
+	explicit FreeListAllocator(FreeListArena *arena)
+		: arena(arena)
+	{
+	}
+
+	template <typename U>
+	FreeListAllocator(const FreeListAllocator<U> &other)
+		: arena(other.arena)
+	{
+	}
+
+	T* allocate(std::size_t n)
+	{
+		if (n != 1)
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		return static_cast<T*>(arena->allocate(sizeof(T)));
+	}
+
+	void deallocate(T *pointer, std::size_t n)
+	{
+		if (n != 1)
+			::operator delete(pointer);
+		else
+			arena->deallocate(pointer);
+	}
+
+	template <typename U>
+	bool operator==(const FreeListAllocator<U> &other) const
+	{
+		return arena == other.arena;
+	}
+
+	template <typename U>
+	bool operator!=(const FreeListAllocator<U> &other) const
+	{
+		return arena != other.arena;
+	}
+
+	FreeListArena *arena;
+};
+
+#endif
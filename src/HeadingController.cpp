@@ -0,0 +1,115 @@
+#include "HeadingController.hpp"
+#include <algorithm>
+#include <cmath>
+
+HeadingController::HeadingController(float maxRate, float maxAcceleration, float kV, float kP, float kD, float minOutput,
+                                     float tolerance, float settleTime, float timeout)
+	: maxRate(maxRate)
+	, maxAcceleration(maxAcceleration)
+	, kV(kV)
+	, kP(kP)
+	, kD(kD)
+	, minOutput(minOutput)
+	, tolerance(tolerance)
+	, settleTime(settleTime)
+	, timeout(timeout)
+	, target(0)
+	, setpoint(0)
+	, setpointRate(0)
+	, startTime(0)
+	, lastTime(0)
+	, lastError(0)
+	, settledSince(-1)
+	, expectedDuration(0)
+	, finished(true)
+{
+	report = TurnReport();
+}
+
+void HeadingController::start(float heading, float degrees, float seconds)
+{
+	target = heading + degrees;
+	setpoint = heading;
+	setpointRate = 0;
+	startTime = seconds;
+	lastTime = seconds;
+	lastError = 0;
+	settledSince = -1;
+	finished = false;
+
+	//length of the trapezoid the setpoint follows
+	float length = std::abs(degrees);
+	float peak = std::min(maxRate, std::sqrt(length * maxAcceleration));
+	expectedDuration = peak > 0 ? length / peak + peak / maxAcceleration : 0;
+
+	report.target = degrees;
+	report.finalError = degrees;
+	report.seconds = 0;
+	report.timedOut = false;
+}
+
+float HeadingController::calculate(float heading, float seconds)
+{
+	if (finished)
+		return 0;
+
+	float dt = seconds - lastTime;
+	lastTime = seconds;
+
+	//move the setpoint toward the target, slowing in time to stop on it
+	float remaining = target - setpoint;
+	float direction = remaining < 0 ? -1.f : 1.f;
+	float wantedRate = direction * std::min(maxRate, std::sqrt(2 * maxAcceleration * std::abs(remaining)));
+	float rateStep = maxAcceleration * dt;
+	setpointRate += std::max(-rateStep, std::min(rateStep, wantedRate - setpointRate));
+	setpoint += setpointRate * dt;
+	if ((target - setpoint) * direction <= 0)
+	{
+		setpoint = target;
+		setpointRate = 0;
+	}
+
+	float error = setpoint - heading;
+	float derivative = dt > 0 ? (error - lastError) / dt : 0;
+	lastError = error;
+
+	float targetError = target - heading;
+	float elapsed = seconds - startTime;
+	report.finalError = targetError;
+	report.seconds = elapsed;
+
+	if (std::abs(targetError) < tolerance)
+	{
+		if (settledSince < 0)
+			settledSince = seconds;
+		if (seconds - settledSince >= settleTime)
+			finished = true;
+	}
+	else
+	{
+		settledSince = -1;
+	}
+
+	if (!finished && elapsed > expectedDuration + timeout)
+	{
+		finished = true;
+		report.timedOut = true;
+	}
+	if (finished)
+		return 0;
+
+	float output = kV * setpointRate + kP * error + kD * derivative;
+	if (std::abs(targetError) >= tolerance && std::abs(output) < minOutput)
+		output = targetError < 0 ? -minOutput : minOutput;
+	return std::max(-1.f, std::min(1.f, output));
+}
+
+bool HeadingController::isFinished() const
+{
+	return finished;
+}
+
+const TurnReport& HeadingController::getReport() const
+{
+	return report;
+}
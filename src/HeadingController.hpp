@@ -0,0 +1,50 @@
+#ifndef HEADING_CONTROLLER_HPP
+#define HEADING_CONTROLLER_HPP
+
+struct TurnReport
+{
+	float target;     //degrees turned relative to the start
+	float finalError; //degrees, target minus where the robot ended up
+	float seconds;
+	bool timedOut;
+};
+
+/**
+ * Closed-loop axis turn on a gyro heading.
+ * The setpoint moves toward the target at a limited rate and acceleration,
+ * the output is rate feedforward plus PD on the heading error, and the turn
+ * is complete once the heading stays inside the tolerance for the settle time.
+ */
+class HeadingController
+{
+public:
+	HeadingController(float maxRate, float maxAcceleration, float kV, float kP, float kD, float minOutput,
+	                  float tolerance, float settleTime, float timeout);
+
+	void start(float heading, float degrees, float seconds); //turn degrees from heading, starting at time seconds
+	float calculate(float heading, float seconds);           //output for the left side, the right side gets the opposite
+	bool isFinished() const;
+	const TurnReport& getReport() const;
+
+private:
+	const float maxRate;
+	const float maxAcceleration;
+	const float kV, kP, kD;
+	const float minOutput;
+	const float tolerance;
+	const float settleTime;
+	const float timeout;
+
+	float target;
+	float setpoint;
+	float setpointRate;
+	float startTime;
+	float lastTime;
+	float lastError;
+	float settledSince;
+	float expectedDuration;
+	bool finished;
+	TurnReport report;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "I2CBusScheduler.hpp"
+
+const int I2CBusScheduler::MAX_DEVICES;
+
+I2CBusScheduler::I2CBusScheduler(int transfersPerSlice)
+	: transfersPerSlice(transfersPerSlice)
+	, clients()
+	, count(0)
+	, statsStart(0)
+	, rateChannel(Telemetry::get()->channel("I2C bus", "device samplesPerSecond requested aborted"))
+{
+}
+
+int I2CBusScheduler::add(LidarI2C *lidar, double hz, int priority)
+{
+	if (count == MAX_DEVICES)
+		return -1;
+
+	Client &client = clients[count];
+	client.lidar = lidar;
+	client.period = 1 / hz;
+	client.priority = priority;
+	client.nextTrigger = 0;
+	client.samples = 0;
+	client.aborted = 0;
+	return count++;
+}
+
+void I2CBusScheduler::update(double now)
+{
+	std::array<bool, MAX_DEVICES> collected = {};
+	std::array<bool, MAX_DEVICES> triggered = {};
+	int transfers = 0;
+
+	while (transfers < transfersPerSlice)
+	{
+		int collect = pickCollect(now, collected);
+		int trigger = pickTrigger(now, triggered);
+		if (collect < 0 && trigger < 0)
+			break;
+		transfers++;
+
+		//at the same priority collect first, a finished measurement only gets older
+		if (collect >= 0 && (trigger < 0 || clients[collect].priority >= clients[trigger].priority))
+		{
+			collected[collect] = true;
+			if (clients[collect].lidar->collect(now))
+				clients[collect].samples++;
+			else
+				clients[collect].aborted++;
+			continue;
+		}
+
+		triggered[trigger] = true;
+		Client &client = clients[trigger];
+		if (!client.lidar->trigger(now))
+		{
+			client.aborted++;
+			continue;
+		}
+
+		//keep to the rate, but a sensor that fell behind doesn't get to catch up in a burst
+		client.nextTrigger += client.period;
+		if (client.nextTrigger < now)
+			client.nextTrigger = now + client.period;
+	}
+}
+
+//the finished measurement to read next, -1 if none is left
+int I2CBusScheduler::pickCollect(double now, const std::array<bool, MAX_DEVICES> &serviced) const
+{
+	int best = -1;
+	for (int i = 0; i < count; i++)
+	{
+		const Client &client = clients[i];
+		if (serviced[i] || !client.lidar->isMeasuring() || now < client.lidar->readyAt())
+			continue;
+		if (best < 0 || before(client, client.lidar->readyAt(), clients[best], clients[best].lidar->readyAt()))
+			best = i;
+	}
+	return best;
+}
+
+//the idle sensor to start next, -1 if none is due
+int I2CBusScheduler::pickTrigger(double now, const std::array<bool, MAX_DEVICES> &serviced) const
+{
+	int best = -1;
+	for (int i = 0; i < count; i++)
+	{
+		const Client &client = clients[i];
+		if (serviced[i] || client.lidar->isMeasuring() || now < client.nextTrigger)
+			continue;
+		if (best < 0 || before(client, client.nextTrigger, clients[best], clients[best].nextTrigger))
+			best = i;
+	}
+	return best;
+}
+
+//higher priority first, then whichever has been due longest
+bool I2CBusScheduler::before(const Client &a, double aTime, const Client &b, double bTime) const
+{
+	if (a.priority != b.priority)
+		return a.priority > b.priority;
+	return aTime < bTime;
+}
+
+double I2CBusScheduler::getSamplesPerSecond(int device, double now) const
+{
+	double elapsed = now - statsStart;
+	return elapsed <= 0 ? 0 : clients[device].samples / elapsed;
+}
+
+long long I2CBusScheduler::getAborted(int device) const
+{
+	return clients[device].aborted;
+}
+
+void I2CBusScheduler::resetStats(double now)
+{
+	statsStart = now;
+	for (int i = 0; i < count; i++)
+	{
+		clients[i].samples = 0;
+		clients[i].aborted = 0;
+	}
+}
+
+void I2CBusScheduler::report(double now)
+{
+	for (int i = 0; i < count; i++)
+		Telemetry::get()->record(rateChannel, i, getSamplesPerSecond(i, now), 1 / clients[i].period, clients[i].aborted);
+}
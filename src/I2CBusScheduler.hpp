@@ -0,0 +1,55 @@
+#ifndef I2C_BUS_SCHEDULER_HPP
+#define I2C_BUS_SCHEDULER_HPP
+
+#include <array>
+#include "LidarI2C.hpp"
+#include "Telemetry.hpp"
+
+/**
+ * Shares one I2C bus between several Lidar-Lites so their measurements overlap.
+ * Each update() is a time slice of at most transfersPerSlice transfers. It
+ * collects every measurement that has finished and triggers every sensor due
+ * by its rate, so all the sensors' 20 ms acquisitions run together instead of
+ * one after another. When a slice can't fit everything, higher priority
+ * sensors go first, then collects before triggers, then whichever has waited
+ * longest.
+ * Call update() from the one thread that owns the bus.
+ */
+class I2CBusScheduler
+{
+public:
+	static const int MAX_DEVICES = 8;
+
+	explicit I2CBusScheduler(int transfersPerSlice = 4);
+
+	int add(LidarI2C *lidar, double hz, int priority = 0); //index for the getters, -1 when full
+	void update(double now);
+
+	double getSamplesPerSecond(int device, double now) const; //since the last resetStats()
+	long long getAborted(int device) const;                   //transfers the sensor didn't acknowledge
+	void resetStats(double now);
+	void report(double now); //achieved and requested rate of every sensor to telemetry
+
+private:
+	struct Client
+	{
+		LidarI2C *lidar;
+		double period;
+		int priority;
+		double nextTrigger;
+		long long samples;
+		long long aborted;
+	};
+
+	int pickCollect(double now, const std::array<bool, MAX_DEVICES> &serviced) const;
+	int pickTrigger(double now, const std::array<bool, MAX_DEVICES> &serviced) const;
+	bool before(const Client &a, double aTime, const Client &b, double bTime) const;
+
+	const int transfersPerSlice;
+	std::array<Client, MAX_DEVICES> clients;
+	int count;
+	double statsStart;
+	const Telemetry::Channel rateChannel;
+};
+
+#endif
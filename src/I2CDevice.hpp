@@ -0,0 +1,19 @@
+#ifndef I2C_DEVICE_HPP
+#define I2C_DEVICE_HPP
+
+#include <cstdint>
+
+/**
+ * One device on an I2C bus, so drivers can be run against a stand-in.
+ * Transfers return true when they were aborted, the same as WPILib's I2C,
+ * which is also what a device that NAKs while it is busy looks like.
+ */
+class I2CDevice
+{
+public:
+	virtual bool write(uint8_t registerAddress, uint8_t data) = 0;
+	virtual bool read(uint8_t registerAddress, uint8_t count, uint8_t *buffer) = 0;
+	virtual ~I2CDevice() {}
+};
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef INLINE_FUNCTION_HPP
+#define INLINE_FUNCTION_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//room for a member function pointer plus an object pointer, with a word to spare
+const std::size_t INLINE_FUNCTION_CAPACITY = 4 * sizeof(void*);
+
+template <typename Signature, std::size_t Capacity = INLINE_FUNCTION_CAPACITY>
+class InlineFunction;
+
+/**
+ * Move-only stand-in for std::function that keeps the callable inside the object.
+ * It never touches the heap. A callable larger than Capacity fails to compile
+ * instead of silently allocating. Calling an empty InlineFunction is undefined.
+ */
+template <typename R, typename... Args, std::size_t Capacity>
+class InlineFunction<R(Args...), Capacity>
+{
+public:
+	InlineFunction()
+		: invoker(nullptr)
+		, manager(nullptr)
+	{
+	}
+
+	template <typename F, typename = typename std::enable_if<
+		!std::is_same<typename std::decay<F>::type, InlineFunction>::value>::type>
+	InlineFunction(F &&func)
+		: invoker(&invoke<typename std::decay<F>::type>)
+		, manager(&manage<typename std::decay<F>::type>)
+	{
+		typedef typename std::decay<F>::type Functor;
+		static_assert(sizeof(Functor) <= Capacity, "callback does not fit in InlineFunction, capture less or raise Capacity");
+		static_assert(alignof(Functor) <= alignof(Storage), "callback is over-aligned for InlineFunction");
+		new (&storage) Functor(std::forward<F>(func));
+	}
+
+	InlineFunction(InlineFunction &&other)
+		: invoker(other.invoker)
+		, manager(other.manager)
+	{
+		if (manager)
+			manager(&storage, &other.storage);
+		other.invoker = nullptr;
+		other.manager = nullptr;
+	}
+
+	InlineFunction& operator=(InlineFunction &&other)
+	{
+		if (this != &other)
+		{
+			reset();
+			invoker = other.invoker;
+			manager = other.manager;
+			if (manager)
+				manager(&storage, &other.storage);
+			other.invoker = nullptr;
+			other.manager = nullptr;
+		}
+		return *this;
+	}
+
+	InlineFunction(const InlineFunction&) = delete;
+	InlineFunction& operator=(const InlineFunction&) = delete;
+
+	~InlineFunction()
+	{
+		reset();
+	}
+
+	R operator()(Args... args) const
+	{
+		return invoker(const_cast<Storage*>(&storage), std::forward<Args>(args)...);
+	}
+
+	explicit operator bool() const
+	{
+		return invoker != nullptr;
+	}
+
+	void reset()
+	{
+		if (manager)
+			manager(nullptr, &storage);
+		invoker = nullptr;
+		manager = nullptr;
+	}
+
+	static std::size_t capacity()
+	{
+		return Capacity;
+	}
+
+private:
+	typedef typename std::aligned_storage<Capacity>::type Storage;
+
+	template <typename Functor>
+	static R invoke(void *object, Args... args)
+	{
+		return (*static_cast<Functor*>(object))(std::forward<Args>(args)...);
+	}
+
+	//moves source into destination when there is one, then destroys source
+	template <typename Functor>
+	static void manage(void *destination, void *source)
+	{
+		Functor *functor = static_cast<Functor*>(source);
+		if (destination)
+			new (destination) Functor(std::move(*functor));
+		functor->~Functor();
+	}
+
+	R (*invoker)(void*, Args...);
+	void (*manager)(void*, void*);
+	Storage storage;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "InputBus.hpp"
+#include <utility>
+
+const int InputBus::MAX_DEVICES;
+const int InputBus::MAX_EVENTS;
+
+InputBus::InputBus()
+	: eventCount(0)
+	, held()
+	, published(0)
+{
+}
+
+void InputBus::subscribe(int device, int button, ButtonEdge edge, Action<void()> action)
+{
+	if (device < 0 || device >= MAX_DEVICES)
+		return;
+	maps[device].associate(button, edge, std::move(action));
+}
+
+void InputBus::subscribe(int device, JoyButton button, Action<void()> action)
+{
+	if (device < 0 || device >= MAX_DEVICES)
+		return;
+	maps[device].associate(button, std::move(action));
+}
+
+ActionMap& InputBus::getMap(int device)
+{
+	return maps[device];
+}
+
+void InputBus::beginFrame()
+{
+	eventCount = 0;
+	published = 0;
+}
+
+void InputBus::publish(int device, const ButtonEdges &edges)
+{
+	if (device < 0 || device >= MAX_DEVICES)
+		return;
+	held[device] = edges.held();
+	published |= 1u << device;
+
+	const uint32_t BOUND = (1u << ActionMap::BUTTONS) - 1;
+	const ButtonEdge ALL_EDGES[] = { ButtonEdge::Down, ButtonEdge::Pressed, ButtonEdge::Up };
+
+	//a button is in at most one edge mask, so each device adds at most BUTTONS events
+	for (ButtonEdge edge : ALL_EDGES)
+	{
+		for (uint32_t mask = edges.mask(edge) & BOUND; mask != 0 && eventCount < MAX_EVENTS; mask &= mask - 1)
+		{
+			InputEvent &event = events[eventCount++];
+			event.device = device;
+			event.button = __builtin_ctz(mask) + 1;
+			event.edge = edge;
+		}
+	}
+}
+
+int InputBus::dispatch(double now)
+{
+	int ran = 0;
+	for (const InputEvent &event : *this)
+		ran += maps[event.device].fire(event.button, event.edge);
+
+	for (uint32_t devices = published; devices != 0; devices &= devices - 1)
+	{
+		int device = __builtin_ctz(devices);
+		ran += maps[device].update(held[device], now);
+	}
+	return ran;
+}
+
+const InputEvent* InputBus::begin() const
+{
+	return events.data();
+}
+
+const InputEvent* InputBus::end() const
+{
+	return events.data() + eventCount;
+}
+
+int InputBus::size() const
+{
+	return eventCount;
+}
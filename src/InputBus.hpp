@@ -0,0 +1,50 @@
+#ifndef INPUT_BUS_HPP
+#define INPUT_BUS_HPP
+
+#include "ActionMap.hpp"
+#include "ButtonEdges.hpp"
+#include <array>
+#include <cstdint>
+
+struct InputEvent
+{
+	uint8_t device;      //driver station port
+	uint8_t button;      //starts at 1, like ButtonNames
+	ButtonEdge edge;
+};
+
+/**
+ * Button events from every driver station device, gathered into one list per frame.
+ * Each device publishes its edges once per loop and subscribers are keyed by
+ * (device, button, edge). The event list is preallocated and sized for every
+ * button of every device, so a frame never allocates or drops events.
+ */
+class InputBus
+{
+public:
+	static const int MAX_DEVICES = 6; //joystick ports on the driver station
+	static const int MAX_EVENTS = MAX_DEVICES * ActionMap::BUTTONS;
+
+	InputBus();
+
+	void subscribe(int device, int button, ButtonEdge edge, Action<void()> action);
+	void subscribe(int device, JoyButton button, Action<void()> action); //every edge flagged in button
+	ActionMap& getMap(int device);
+
+	void beginFrame(); //clears the event list
+	void publish(int device, const ButtonEdges &edges);
+	int dispatch(double now); //runs the subscribers of every event, chord and hold this frame, returns how many ran
+
+	const InputEvent* begin() const;
+	const InputEvent* end() const;
+	int size() const;
+
+private:
+	std::array<ActionMap, MAX_DEVICES> maps;
+	std::array<InputEvent, MAX_EVENTS> events;
+	int eventCount;
+	std::array<uint32_t, MAX_DEVICES> held; //buttons each device holds this frame, for chords and holds
+	uint32_t published;                      //bit per device that published this frame
+};
+
+#endif
@@ -0,0 +1,292 @@
+#include "InputRecording.hpp"
+#include <cmath>
+#include <cstdio>
+
+const std::size_t InputRecorder::RESERVED_BYTES;
+
+namespace
+{
+	const uint8_t MAGIC[3] = { 'I', 'N', 'P' };
+	const uint8_t VERSION = 1;
+	const std::size_t HEADER_SIZE = 6; //magic, version, device bits, axes per device
+
+	const std::size_t MAX_VARINT_BYTES = 10; //a uint64_t at 7 bits a byte
+	const std::size_t MAX_BUTTON_BYTES = 5;  //32 button bits
+
+	const uint8_t BUTTONS_CHANGED = 1;
+	uint8_t axisChanged(int axis)
+	{
+		return 2 << axis;
+	}
+}
+
+int8_t InputSample::toRaw(float value)
+{
+	long raw = std::lround(value < 0 ? value * 128 : value * 127);
+	if (raw < -128)
+		raw = -128;
+	if (raw > 127)
+		raw = 127;
+	return static_cast<int8_t>(raw);
+}
+
+InputRecorder::InputRecorder(uint8_t devices)
+	: devices(devices)
+	, maxFrameBytes(MAX_VARINT_BYTES)
+{
+	for (int port = 0; port < INPUT_DEVICES; port++)
+	{
+		if (devices & (1 << port))
+			maxFrameBytes += 1 + MAX_BUTTON_BYTES + INPUT_AXES;
+	}
+	bytes.reserve(RESERVED_BYTES);
+	clear();
+}
+
+void InputRecorder::clear()
+{
+	bytes.clear();
+	isFull = false;
+	frameCount = 0;
+	start = 0;
+	lastMicroseconds = 0;
+	last = InputFrame();
+	writeHeader();
+}
+
+bool InputRecorder::record(const InputFrame &frame)
+{
+	if (isFull || bytes.size() + maxFrameBytes > RESERVED_BYTES)
+	{
+		isFull = true;
+		return false;
+	}
+
+	if (frameCount == 0)
+		start = frame.time;
+
+	double seconds = frame.time - start;
+	uint64_t microseconds = seconds <= 0 ? 0 : static_cast<uint64_t>(std::llround(seconds * 1e6));
+	if (microseconds < lastMicroseconds) //keeps replay in order if the clock ever steps back
+		microseconds = lastMicroseconds;
+	writeVarint(microseconds - lastMicroseconds);
+	lastMicroseconds = microseconds;
+
+	for (int port = 0; port < INPUT_DEVICES; port++)
+	{
+		if ((devices & (1 << port)) == 0)
+			continue;
+
+		const InputSample &sample = frame.devices[port];
+		const InputSample &previous = last.devices[port];
+
+		uint8_t changed = sample.buttons != previous.buttons ? BUTTONS_CHANGED : 0;
+		for (int axis = 0; axis < INPUT_AXES; axis++)
+		{
+			if (sample.axes[axis] != previous.axes[axis])
+				changed |= axisChanged(axis);
+		}
+
+		bytes.push_back(changed);
+		if (changed & BUTTONS_CHANGED)
+			writeVarint(sample.buttons ^ previous.buttons);
+		for (int axis = 0; axis < INPUT_AXES; axis++)
+		{
+			if (changed & axisChanged(axis))
+				bytes.push_back(static_cast<uint8_t>(sample.axes[axis] - previous.axes[axis]));
+		}
+	}
+
+	last = frame;
+	frameCount++;
+	return true;
+}
+
+bool InputRecorder::full() const
+{
+	return isFull;
+}
+
+const std::vector<uint8_t>& InputRecorder::data() const
+{
+	return bytes;
+}
+
+std::size_t InputRecorder::frames() const
+{
+	return frameCount;
+}
+
+bool InputRecorder::write(const std::string &file) const
+{
+	std::FILE *out = std::fopen(file.c_str(), "wb");
+	if (out == nullptr)
+		return false;
+
+	bool ok = std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+	return std::fclose(out) == 0 && ok;
+}
+
+void InputRecorder::writeHeader()
+{
+	bytes.insert(bytes.end(), MAGIC, MAGIC + sizeof(MAGIC));
+	bytes.push_back(VERSION);
+	bytes.push_back(devices);
+	bytes.push_back(INPUT_AXES);
+}
+
+void InputRecorder::writeVarint(uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		bytes.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back(static_cast<uint8_t>(value));
+}
+
+InputPlayer::InputPlayer()
+	: position(0)
+	, devices(0)
+	, microseconds(0)
+	, ended(true)
+{
+}
+
+bool InputPlayer::open(const std::string &file)
+{
+	std::FILE *in = std::fopen(file.c_str(), "rb");
+	if (in == nullptr)
+		return false;
+
+	std::vector<uint8_t> data;
+	uint8_t buffer[4096];
+	std::size_t read;
+	while ((read = std::fread(buffer, 1, sizeof(buffer), in)) > 0)
+		data.insert(data.end(), buffer, buffer + read);
+	std::fclose(in);
+	return load(data);
+}
+
+bool InputPlayer::load(const std::vector<uint8_t> &data)
+{
+	ended = true;
+	if (data.size() < HEADER_SIZE
+		|| data[0] != MAGIC[0] || data[1] != MAGIC[1] || data[2] != MAGIC[2]
+		|| data[3] != VERSION || data[5] != INPUT_AXES)
+		return false;
+
+	bytes = data;
+	devices = bytes[4];
+	rewind();
+	return true;
+}
+
+void InputPlayer::rewind()
+{
+	position = HEADER_SIZE;
+	microseconds = 0;
+	current = InputFrame();
+	ended = bytes.size() <= HEADER_SIZE;
+}
+
+bool InputPlayer::next(InputFrame &frame)
+{
+	uint64_t delta;
+	if (ended || !readVarint(delta))
+	{
+		ended = true;
+		return false;
+	}
+	microseconds += delta;
+
+	for (int port = 0; port < INPUT_DEVICES; port++)
+	{
+		if ((devices & (1 << port)) == 0)
+			continue;
+		if (position >= bytes.size())
+		{
+			ended = true;
+			return false;
+		}
+
+		InputSample &sample = current.devices[port];
+		uint8_t changed = bytes[position++];
+		uint64_t flipped;
+		if (changed & BUTTONS_CHANGED)
+		{
+			if (!readVarint(flipped))
+			{
+				ended = true;
+				return false;
+			}
+			sample.buttons ^= static_cast<uint32_t>(flipped);
+		}
+		for (int axis = 0; axis < INPUT_AXES; axis++)
+		{
+			if ((changed & axisChanged(axis)) == 0)
+				continue;
+			if (position >= bytes.size())
+			{
+				ended = true;
+				return false;
+			}
+			sample.axes[axis] = static_cast<int8_t>(sample.axes[axis] + bytes[position++]);
+		}
+	}
+
+	current.time = microseconds / 1e6;
+	frame = current;
+	if (position >= bytes.size())
+		ended = true;
+	return true;
+}
+
+bool InputPlayer::advance(double elapsed, InputFrame &frame)
+{
+	double due;
+	if (!peekTime(due) || due > elapsed)
+		return false;
+	return next(frame);
+}
+
+bool InputPlayer::finished() const
+{
+	return ended;
+}
+
+uint8_t InputPlayer::getDevices() const
+{
+	return devices;
+}
+
+bool InputPlayer::readVarint(uint64_t &value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64 && position < bytes.size(); shift += 7)
+	{
+		uint8_t byte = bytes[position++];
+		value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+			return true;
+	}
+	return false;
+}
+
+bool InputPlayer::peekTime(double &time) const
+{
+	if (ended)
+		return false;
+
+	uint64_t delta = 0;
+	for (std::size_t i = position, shift = 0; i < bytes.size() && shift < 64; i++, shift += 7)
+	{
+		delta |= static_cast<uint64_t>(bytes[i] & 0x7f) << shift;
+		if ((bytes[i] & 0x80) == 0)
+		{
+			time = (microseconds + delta) / 1e6;
+			return true;
+		}
+	}
+	return false;
+}
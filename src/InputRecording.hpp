@@ -0,0 +1,114 @@
+#ifndef INPUT_RECORDING_HPP
+#define INPUT_RECORDING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+const int INPUT_DEVICES = 6;   //joystick ports on the driver station
+const int INPUT_AXES = 6;      //axes kept per device, the Extreme 3D uses 4 and the GameCube adapter 6
+
+//one device's state from one driver station packet, axes as the driver station's raw bytes
+struct InputSample
+{
+	uint32_t buttons;
+	std::array<int8_t, INPUT_AXES> axes;
+
+	InputSample()
+		: buttons(0)
+		, axes()
+	{
+	}
+
+	float axis(int index) const //-1 to 1, scaled the way Joystick::GetRawAxis() does
+	{
+		int8_t raw = axes[index];
+		return raw < 0 ? raw / 128.f : raw / 127.f;
+	}
+
+	static int8_t toRaw(float value);
+};
+
+struct InputFrame
+{
+	double time; //seconds, a recording's frames start at 0
+	std::array<InputSample, INPUT_DEVICES> devices;
+
+	InputFrame()
+		: time(0)
+	{
+	}
+};
+
+/**
+ * Records driver input into a delta-encoded byte stream.
+ * Each frame is a varint of microseconds since the last frame, then for every
+ * recorded device a byte flagging what changed, the changed button bits as a
+ * varint, and one byte per changed axis. The 20 ms delta alone takes 3 bytes,
+ * so two idle sticks cost 5 bytes a frame and two jittering ones up to 17.
+ * The stream never grows past the space reserved up front: a frame that might
+ * not fit isn't recorded and full() turns true, so record() never allocates.
+ */
+class InputRecorder
+{
+public:
+	//two sticks with every field changing every frame for a 150 s match at 50 Hz
+	static const std::size_t RESERVED_BYTES = 256 * 1024;
+
+	explicit InputRecorder(uint8_t devices); //bit per driver station port to record
+	void clear();
+	bool record(const InputFrame &frame); //false once full, the frame is dropped
+	bool full() const;
+
+	const std::vector<uint8_t>& data() const;
+	std::size_t frames() const;
+	bool write(const std::string &file) const;
+
+private:
+	uint8_t devices;
+	std::size_t maxFrameBytes; //time varint plus, per device, flags, button varint and every axis
+	bool isFull;
+	std::vector<uint8_t> bytes;
+	std::size_t frameCount;
+	double start;
+	uint64_t lastMicroseconds;
+	InputFrame last;
+
+	void writeHeader();
+	void writeVarint(uint64_t value);
+};
+
+/**
+ * Reads a stream written by InputRecorder back one frame at a time.
+ * Frames keep the timestamps they were recorded with, so the caller decides
+ * whether to pace them in real time or run them as fast as it can.
+ */
+class InputPlayer
+{
+public:
+	InputPlayer();
+
+	bool open(const std::string &file);
+	bool load(const std::vector<uint8_t> &data); //false when the header doesn't match
+	void rewind();
+
+	bool next(InputFrame &frame);                  //false at the end of the stream
+	bool advance(double elapsed, InputFrame &frame); //next frame if it is due by elapsed seconds, never skips frames
+	bool finished() const;
+	uint8_t getDevices() const;
+
+private:
+	std::vector<uint8_t> bytes;
+	std::size_t position;
+	uint8_t devices;
+	uint64_t microseconds;
+	InputFrame current;
+	bool ended;
+
+	bool readVarint(uint64_t &value);
+	bool peekTime(double &time) const;
+};
+
+#endif
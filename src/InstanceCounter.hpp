@@ -0,0 +1,42 @@
+#ifndef INSTANCE_COUNTER_HPP
+#define INSTANCE_COUNTER_HPP
+
+#include <atomic>
+
+/**
+ * Inherit from InstanceCounter<Derived> to keep a count of how many Derived
+ * objects are currently alive.
+ */
+template <typename T>
+class InstanceCounter
+{
+public:
+	static int live()
+	{
+		return count.load();
+	}
+
+protected:
+	InstanceCounter()
+	{
+		count++;
+	}
+
+	InstanceCounter(const InstanceCounter&)
+	{
+		count++;
+	}
+
+	~InstanceCounter()
+	{
+		count--;
+	}
+
+private:
+	static std::atomic<int> count;
+};
+
+template <typename T>
+std::atomic<int> InstanceCounter<T>::count(0);
+
+#endif
@@ -2,19 +2,26 @@
 
 JoyButton::JoyButton()
 	: name()
+	, chord(0)
+	, holdSeconds(0)
 {
 	down = false;
 	pressed = false;
 	up = false;
 }
 JoyButton::JoyButton(ButtonNames name)
-	: name(name)
+	: down(false)
+	, pressed(false)
+	, up(false)
+	, name(name)
+	, chord(0)
+	, holdSeconds(0)
 {
-	std::cout << "Button #2" << std::endl;
 }
 
 JoyButton::JoyButton(const JoyButton& button)
 	: down(button.down), pressed(button.pressed), up(button.up), name(button.name)
+	, chord(button.chord), holdSeconds(button.holdSeconds)
 {
 
 }
@@ -24,16 +31,45 @@ JoyButton::JoyButton(bool wouldBeDown, bool wouldBePressed, bool wouldBeUp, Butt
 	, pressed(wouldBePressed)
 	, up(wouldBeUp)
 	, name(name)
+	, chord(0)
+	, holdSeconds(0)
+{
+}
+
+JoyButton JoyButton::together(ButtonNames name, ButtonNames other)
+{
+	JoyButton button;
+	button.name = name;
+	button.chord = 1u << (other - 1);
+	return button;
+}
+
+JoyButton JoyButton::held(ButtonNames name, float seconds)
+{
+	JoyButton button;
+	button.name = name;
+	button.holdSeconds = seconds;
+	return button;
+}
+
+JoyButton JoyButton::whileHeld(ButtonNames name)
+{
+	JoyButton button;
+	button.name = name;
+	button.down = true;
+	button.pressed = true;
+	return button;
+}
+
+bool JoyButton::isCombo() const
 {
-	std::cout << std::boolalpha << wouldBeDown << "down\t"
-			  	  	  	  	    << wouldBeUp << "up\t"
-								<< wouldBePressed << "pressed\t"
-								<< name << "button name" << std::endl;
+	return chord != 0 || holdSeconds > 0;
 }
 
 inline bool JoyButton::operator==(const JoyButton& right)
 {
-	if ((down == right.down) && (pressed == right.pressed) && (up == right.up) && (name == right.name))
+	if ((down == right.down) && (pressed == right.pressed) && (up == right.up) && (name == right.name)
+		&& (chord == right.chord) && (holdSeconds == right.holdSeconds))
 		return true;
 	else
 		return false;
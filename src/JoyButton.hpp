@@ -28,6 +28,8 @@ public:
 	bool pressed;
 	bool up;
 	ButtonNames name;
+	uint32_t chord;      //other buttons that must be held with this one, as ButtonEdges bits
+	float holdSeconds;   //how long the chord must be held before it fires, 0 fires as soon as it is complete
 	inline bool operator==(const JoyButton& right);
 	bool operator<(const JoyButton& right) const;
 	JoyButton();
@@ -35,6 +37,11 @@ public:
 	JoyButton(ButtonNames name);
 	JoyButton(bool wouldBeDown, bool wouldBePressed, bool wouldBeUp, ButtonNames name);
 
+	static JoyButton together(ButtonNames name, ButtonNames other);
+	static JoyButton held(ButtonNames name, float seconds);
+	static JoyButton whileHeld(ButtonNames name); //down and every pressed poll, for commands that only last one loop
+	bool isCombo() const; //chords and holds fire once per hold instead of on an edge
+
 	friend std::ostream& operator<<(std::ostream &out, JoyButton &joyButton);
 
 };
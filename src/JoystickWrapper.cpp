@@ -1,77 +1,51 @@
 #include "JoystickWrapper.hpp"
+#include "HAL/HAL.hpp"
 
-//for GetRawNumber() down is true
-
-bool JoystickWrapper::checkDown(JoyButton joyButton, ButtonNames butt)
+//one read of the button word and the axes per poll, instead of a GetRawButton() per button per check
+void JoystickWrapper::pollJoystick()
 {
-	if(!joyButton.down && !joyButton.pressed && joystick->GetRawButton(butt))
-		return true;
-	else
-		return false;
+	HALJoystickButtons buttons;
+	buttons.buttons = 0;
+	buttons.count = 0;
+	HALGetJoystickButtons(port, &buttons);
+
+	HALJoystickAxes axes;
+	axes.count = 0;
+	HALGetJoystickAxes(port, &axes);
+
+	InputSample live;
+	uint32_t plugged = buttons.count >= 32 ? ~0u : (1u << buttons.count) - 1;
+	live.buttons = buttons.buttons & plugged;
+	for (int i = 0; i < INPUT_AXES && i < axes.count; i++)
+		live.axes[i] = static_cast<int8_t>(axes.axes[i]);
+	pollJoystick(live);
 }
 
-bool JoystickWrapper::checkUp(JoyButton joyButton, ButtonNames butt)
+void JoystickWrapper::pollJoystick(const InputSample &replayed)
 {
-	if((joyButton.down || joyButton.pressed) && !joyButton.up && !joystick->GetRawButton(butt))
-		return true;
-	else
-		return false;
+	sample = replayed;
+	edges.update(sample.buttons);
 }
 
-bool JoystickWrapper::checkPressed(JoyButton joyButton, ButtonNames butt)
+const InputSample& JoystickWrapper::getSample() const
 {
-	if((joyButton.down || joyButton.pressed) && !joyButton.up && joystick->GetRawButton(butt))
-		return true;
-	else
-		return false;
+	return sample;
 }
 
-
-void JoystickWrapper::pollJoystick()
+float JoystickWrapper::getAxis(int axis) const
 {
-	for (unsigned int i = 0; i < joyButtons.size() && i < joystick->GetButtonCount(); i++)
-	{
-		if(checkUp(joyButtons[i], static_cast<ButtonNames>(i + 1)))
-		{
-			joyButtons[i].up = true;
-		}
-		else
-		{
-			joyButtons[i].up = false;
-		}
-		if(checkPressed(joyButtons[i], static_cast<ButtonNames>(i + 1)))
-		{
-			joyButtons[i].pressed = true;
-		}
-		else
-		{
-			joyButtons[i].pressed = false;
-		}
-		if(checkDown(joyButtons[i], static_cast<ButtonNames>(i + 1)))
-		{
-			joyButtons[i].down = true;
-		}
-		else
-		{
-			joyButtons[i].down = false;
-		}
-
-	}
+	return axis >= 0 && axis < INPUT_AXES ? sample.axis(axis) : 0;
 }
 
-const std::array<JoyButton, 12>& JoystickWrapper::getStates()
+const ButtonEdges& JoystickWrapper::getEdges() const
 {
-	return joyButtons;
+	return edges;
 }
 
 JoystickWrapper::JoystickWrapper(int port)
 	: joystick(new Joystick(port))
-	, joyButtons()
+	, port(port)
 {
-	for(unsigned int i = 0; i < joyButtons.size(); i++)
-	{
-		joyButtons[i].name = static_cast<ButtonNames>(i + 1);
-	}
 }
 
 Joystick* JoystickWrapper::getJoystick()
@@ -3,24 +3,26 @@
 
 #include <WPILib.h>
 #include <iostream>
-#include <array>
 
-#include "JoyButton.hpp"
+#include "ButtonEdges.hpp"
+#include "InputRecording.hpp"
 
 class JoystickWrapper
 {
 public:
 	void pollJoystick();
-	const std::array<JoyButton, 12>& getStates();
+	void pollJoystick(const InputSample &replayed); //takes this sample in place of the live stick
+	const ButtonEdges& getEdges() const;
+	const InputSample& getSample() const;
+	float getAxis(int axis) const; //from the last poll, like Joystick::GetRawAxis()
 	JoystickWrapper(int port);
 	Joystick* getJoystick();
 	~JoystickWrapper();
 private:
 	Joystick *joystick;
-	std::array<JoyButton, 12> joyButtons;
-	bool checkDown(JoyButton joyButton, ButtonNames butt);
-	bool checkUp(JoyButton joyButton, ButtonNames butt);
-	bool checkPressed(JoyButton joyButton, ButtonNames butt);
+	uint8_t port;
+	ButtonEdges edges;
+	InputSample sample;
 };
 
 #endif
@@ -0,0 +1,109 @@
+#include "LatencyHistogram.hpp"
+#include <cmath>
+
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const uint32_t LatencyHistogram::SUB_BUCKETS;
+const int LatencyHistogram::VALUE_BITS;
+const uint32_t LatencyHistogram::MAX_VALUE;
+const int LatencyHistogram::BUCKETS;
+
+namespace
+{
+	const uint32_t HALF = LatencyHistogram::SUB_BUCKETS / 2;
+}
+
+LatencyHistogram::LatencyHistogram()
+{
+	reset();
+}
+
+void LatencyHistogram::record(uint32_t microseconds)
+{
+	if (microseconds > MAX_VALUE)
+		microseconds = MAX_VALUE;
+
+	buckets[bucketFor(microseconds)]++;
+	total++;
+	sum += microseconds;
+	if (microseconds < smallest)
+		smallest = microseconds;
+	if (microseconds > largest)
+		largest = microseconds;
+}
+
+void LatencyHistogram::reset()
+{
+	buckets.fill(0);
+	total = 0;
+	smallest = MAX_VALUE;
+	largest = 0;
+	sum = 0;
+}
+
+uint32_t LatencyHistogram::count() const
+{
+	return total;
+}
+
+uint32_t LatencyHistogram::min() const
+{
+	return total == 0 ? 0 : smallest;
+}
+
+uint32_t LatencyHistogram::max() const
+{
+	return largest;
+}
+
+double LatencyHistogram::mean() const
+{
+	return total == 0 ? 0 : static_cast<double>(sum) / total;
+}
+
+uint32_t LatencyHistogram::percentile(double percent) const
+{
+	if (total == 0)
+		return 0;
+
+	uint64_t target = static_cast<uint64_t>(std::ceil(percent / 100.0 * total));
+	if (target < 1)
+		target = 1;
+
+	uint64_t seen = 0;
+	for (int i = 0; i < BUCKETS; i++)
+	{
+		seen += buckets[i];
+		if (seen >= target)
+			return highestIn(i) < largest ? highestIn(i) : largest;
+	}
+	return largest;
+}
+
+int LatencyHistogram::bucketFor(uint32_t value)
+{
+	if (value < SUB_BUCKETS)
+		return value;
+
+	//shift keeps the top SUB_BUCKET_BITS bits, whose leading bit is always set
+	int shift = (31 - __builtin_clz(value)) - (SUB_BUCKET_BITS - 1);
+	return SUB_BUCKETS + (shift - 1) * HALF + ((value >> shift) - HALF);
+}
+
+uint32_t LatencyHistogram::lowestIn(int bucket)
+{
+	if (bucket < static_cast<int>(SUB_BUCKETS))
+		return bucket;
+
+	int offset = bucket - SUB_BUCKETS;
+	int shift = offset / HALF + 1;
+	return (offset % HALF + HALF) << shift;
+}
+
+uint32_t LatencyHistogram::highestIn(int bucket)
+{
+	if (bucket < static_cast<int>(SUB_BUCKETS))
+		return bucket;
+
+	int shift = (bucket - SUB_BUCKETS) / HALF + 1;
+	return lowestIn(bucket) + (1u << shift) - 1;
+}
@@ -0,0 +1,45 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <cstdint>
+
+/**
+ * HDR-style histogram of latencies in microseconds.
+ * Values under 32 us are exact. Above that each power of two is split into 16
+ * buckets, so any reported value is within 1/16 of what was recorded.
+ * Storage is a fixed array and recording is a few integer ops, cheap enough for every loop.
+ */
+class LatencyHistogram
+{
+public:
+	static const int SUB_BUCKET_BITS = 5;
+	static const uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+	static const int VALUE_BITS = 24;                          //values clamp at about 16.7 s
+	static const uint32_t MAX_VALUE = (1u << VALUE_BITS) - 1;
+	static const int BUCKETS = SUB_BUCKETS + (VALUE_BITS - SUB_BUCKET_BITS) * (SUB_BUCKETS / 2);
+
+	LatencyHistogram();
+
+	void record(uint32_t microseconds);
+	void reset();
+
+	uint32_t count() const;
+	uint32_t min() const;
+	uint32_t max() const;
+	double mean() const;
+	uint32_t percentile(double percent) const; //highest value the bucket holding that percentile can contain
+
+	static int bucketFor(uint32_t value);
+	static uint32_t lowestIn(int bucket);
+	static uint32_t highestIn(int bucket);
+
+private:
+	std::array<uint32_t, BUCKETS> buckets;
+	uint32_t total;
+	uint32_t smallest;
+	uint32_t largest;
+	uint64_t sum;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "LatencyTracer.hpp"
+#include <cmath>
+
+const int LatencyTracer::PATHS;
+LatencyTracer *LatencyTracer::instance = nullptr;
+
+LatencyTracer* LatencyTracer::get()
+{
+	if (instance == nullptr)
+		instance = new LatencyTracer();
+	return instance;
+}
+
+LatencyTracer::LatencyTracer()
+	: packets(0)
+	, lastArrival(0)
+{
+	const char *NAMES[PATHS] = { "Latency drive us", "Latency lifter us", "Latency shifter us" };
+	for (int i = 0; i < PATHS; i++)
+		channels[i] = Telemetry::get()->channel(NAMES[i], "count p50 p99 max");
+	reset();
+}
+
+uint32_t LatencyTracer::packetArrived(double now)
+{
+	lastArrival = now;
+	return ++packets;
+}
+
+void LatencyTracer::tag(LatencyPath path)
+{
+	Pending &slot = pending[static_cast<int>(path)];
+	if (slot.waiting)
+		return;
+	slot.waiting = true;
+	slot.hasTarget = false;
+	slot.arrival = lastArrival;
+}
+
+void LatencyTracer::tag(LatencyPath path, double target, double tolerance)
+{
+	Pending &slot = pending[static_cast<int>(path)];
+	if (slot.waiting && slot.hasTarget && std::abs(target - slot.target) <= tolerance)
+		return;
+	slot.waiting = true;
+	slot.hasTarget = true;
+	slot.arrival = lastArrival;
+	slot.target = target;
+	slot.tolerance = tolerance;
+}
+
+bool LatencyTracer::issued(LatencyPath path, double now)
+{
+	Pending &slot = pending[static_cast<int>(path)];
+	if (!slot.waiting)
+		return false;
+
+	double seconds = now - slot.arrival;
+	histograms[static_cast<int>(path)].record(seconds <= 0 ? 0 : static_cast<uint32_t>(std::lround(seconds * 1e6)));
+	slot.waiting = false;
+	return true;
+}
+
+bool LatencyTracer::issued(LatencyPath path, double output, double now)
+{
+	Pending &slot = pending[static_cast<int>(path)];
+	if (slot.waiting && slot.hasTarget && std::abs(output - slot.target) > slot.tolerance)
+		return false;
+	return issued(path, now);
+}
+
+const LatencyHistogram& LatencyTracer::getHistogram(LatencyPath path) const
+{
+	return histograms[static_cast<int>(path)];
+}
+
+void LatencyTracer::reset()
+{
+	for (int i = 0; i < PATHS; i++)
+	{
+		pending[i].waiting = false;
+		pending[i].hasTarget = false;
+		histograms[i].reset();
+	}
+}
+
+void LatencyTracer::report()
+{
+	for (int i = 0; i < PATHS; i++)
+	{
+		const LatencyHistogram &histogram = histograms[i];
+		Telemetry::get()->record(channels[i], histogram.count(), histogram.percentile(50), histogram.percentile(99), histogram.max());
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef LATENCY_TRACER_HPP
+#define LATENCY_TRACER_HPP
+
+#include "LatencyHistogram.hpp"
+#include "Telemetry.hpp"
+#include <array>
+#include <cstdint>
+
+enum class LatencyPath
+{
+	Drive,
+	Lifter,
+	Shifter
+};
+
+/**
+ * Measures how long driver input takes to reach an actuator.
+ * packetArrived() stamps each driver station packet. tag() marks a path's
+ * input as coming from the latest packet, and issued() records the time since
+ * that packet once the output goes out. A tag with a target is only answered
+ * when the output gets within tolerance of it, so filter lag is counted too.
+ * Times are passed in, in seconds, so tests can inject packets on their own clock.
+ * Call everything from the robot loop thread.
+ */
+class LatencyTracer
+{
+public:
+	static const int PATHS = 3;
+
+	static LatencyTracer* get();
+	LatencyTracer();
+
+	uint32_t packetArrived(double now); //returns the packet's number
+	void tag(LatencyPath path); //an earlier tag that hasn't been answered keeps its older stamp
+	void tag(LatencyPath path, double target, double tolerance); //restarts when the target moves by more than tolerance
+	bool issued(LatencyPath path, double now); //returns true when a latency was recorded
+	bool issued(LatencyPath path, double output, double now);
+
+	const LatencyHistogram& getHistogram(LatencyPath path) const;
+	void reset();
+	void report(); //count, median, 99th percentile and max of each path, to telemetry
+
+private:
+	struct Pending
+	{
+		bool waiting;
+		bool hasTarget;
+		double arrival;
+		double target;
+		double tolerance;
+	};
+
+	static LatencyTracer *instance;
+
+	uint32_t packets;
+	double lastArrival;
+	std::array<Pending, PATHS> pending;
+	std::array<LatencyHistogram, PATHS> histograms;
+	std::array<Telemetry::Channel, PATHS> channels;
+};
+
+#endif
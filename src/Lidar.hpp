@@ -1,7 +1,7 @@
 #ifndef LIDAR_HPP
 #define LIDAR_HPP
 
-#include <wpilib.h>
+#include <WPILib.h>
 #include <iostream>
 #include <chrono>
 
@@ -1,45 +1,120 @@
 #include "LidarI2C.hpp"
+#include <cmath>
+#include <limits>
 
-void LidarI2C::readyUp()
+const uint8_t LidarI2C::DEFAULT_ADDRESS;
+const int LidarI2C::READ_TRIES;
+const double LidarI2C::MEASURE_SECONDS = 0.02;
+
+namespace
 {
-	const int tries = 5;
-	int ret = 1;
-	for (int i = 0; ret != 0 && i < tries; i++)
-	{
-		ret = lidar->Write(0x00, 0x04);
-		std::cout << ret << '\t' << i << std::endl;
-		::Wait(0.004);
-	}
-}
+	const uint8_t COMMAND_REGISTER = 0x00;
+	const uint8_t ACQUIRE = 0x04;           //measure with DC bias correction
+	const uint8_t DISTANCE_REGISTER = 0x8f; //high byte then low byte, auto-incrementing
+	const uint8_t SERIAL_REGISTER = 0x96;
+	const uint8_t SERIAL_HIGH_REGISTER = 0x18;
+	const uint8_t SERIAL_LOW_REGISTER = 0x19;
+	const uint8_t ADDRESS_REGISTER = 0x1a;
+	const uint8_t ADDRESS_CONTROL_REGISTER = 0x1e;
+	const uint8_t DISABLE_DEFAULT_ADDRESS = 0x08;
 
+	const uint64_t VALID = 1ull << 63;
+	const int CENTIMETERS_SHIFT = 47;
+	const uint64_t MICROSECONDS_MASK = (1ull << CENTIMETERS_SHIFT) - 1;
+}
 
-LidarI2C::LidarI2C(I2C::Port port, char address)
-	: lidar(new I2C(port, address))
+LidarI2C::LidarI2C(std::unique_ptr<I2CDevice> device)
+	: device(std::move(device))
+	, phase(Phase::Trigger)
+	, triggeredAt(0)
+	, readTries(0)
+	, buffer()
+	, reading(0)
+	, abortChannel(Telemetry::get()->channel("LidarI2C aborted", "collecting attempt"))
 {
-	::Wait(0.02);
-	readyUp();
 }
 
-double LidarI2C::getDistance() //returns distance in centimeters
+void LidarI2C::update(double now)
 {
-	const int tries = 10;
-	int ret = 1;
+	if (phase == Phase::Collect && !collect(now) && phase == Phase::Collect)
+		return;
+
+	//the next measurement starts in the same call the last one was collected
+	trigger(now);
+}
 
-	readyUp();
-	unsigned char *distArray = new unsigned char[8];
-	for (int i = 0; ret != 0 && i < tries; i++)
+bool LidarI2C::trigger(double now)
+{
+	if (device->write(COMMAND_REGISTER, ACQUIRE))
 	{
-		::Wait(0.003);
-		ret = lidar->Read(0x8f, 2, distArray);
+		TELEMETRY_VERBOSE_RECORD(abortChannel, 0, 0);
+		phase = Phase::Trigger;
+		return false;
+	}
+	phase = Phase::Collect;
+	triggeredAt = now;
+	readTries = 0;
+	return true;
+}
+
+bool LidarI2C::collect(double now)
+{
+	if (phase != Phase::Collect || now < readyAt())
+		return false;
 
+	if (device->read(DISTANCE_REGISTER, buffer.size(), buffer.data()))
+	{
+		//still busy or the transfer failed, try again next time and start over if it keeps failing
+		TELEMETRY_VERBOSE_RECORD(abortChannel, 1, readTries);
+		if (++readTries >= READ_TRIES)
+			phase = Phase::Trigger;
+		return false;
 	}
 
-	int centimeters = (distArray[0] << 8) + distArray[1];
+	publish((buffer[0] << 8) | buffer[1], now);
+	phase = Phase::Trigger;
+	return true;
+}
 
-	delete[] distArray;
+bool LidarI2C::isMeasuring() const
+{
+	return phase == Phase::Collect;
+}
+
+double LidarI2C::readyAt() const
+{
+	return triggeredAt + MEASURE_SECONDS;
+}
 
-	return centimeters;
-	return 0;
+//the sensor only takes a new address when it is sent its own serial number first
+bool LidarI2C::changeAddress(I2CDevice &device, uint8_t address)
+{
+	uint8_t serial[2];
+	return !device.read(SERIAL_REGISTER, sizeof(serial), serial)
+		&& !device.write(SERIAL_HIGH_REGISTER, serial[0])
+		&& !device.write(SERIAL_LOW_REGISTER, serial[1])
+		&& !device.write(ADDRESS_REGISTER, address)
+		&& !device.write(ADDRESS_CONTROL_REGISTER, DISABLE_DEFAULT_ADDRESS);
+}
+
+double LidarI2C::getDistance() //returns distance in centimeters
+{
+	uint64_t packed = reading.load();
+	return static_cast<double>(packed >> CENTIMETERS_SHIFT & 0xffff);
+}
+
+double LidarI2C::getAge(double now) const
+{
+	uint64_t packed = reading.load();
+	if ((packed & VALID) == 0)
+		return std::numeric_limits<double>::infinity();
+	return now - (packed & MICROSECONDS_MASK) / 1e6;
+}
+
+void LidarI2C::publish(uint16_t centimeters, double now)
+{
+	uint64_t microseconds = now <= 0 ? 0 : static_cast<uint64_t>(std::llround(now * 1e6)) & MICROSECONDS_MASK;
+	reading.store(VALID | static_cast<uint64_t>(centimeters) << CENTIMETERS_SHIFT | microseconds);
 }
 
 double LidarI2C::PIDGet()
@@ -49,5 +124,4 @@ double LidarI2C::PIDGet()
 
 LidarI2C::~LidarI2C()
 {
-	delete lidar;
 }
@@ -1,20 +1,62 @@
 #ifndef LIDAR_I2C
 #define LIDAR_I2C
 
-#include <iostream>
-#include <wpilib.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include "Lidar.hpp"
+#include "I2CDevice.hpp"
+#include "Telemetry.hpp"
 
+/**
+ * Lidar-Lite over I2C, read without ever waiting on the bus.
+ * update() is one step of a two phase cycle: trigger a measurement, then on a
+ * later call, once MEASURE_SECONDS have passed, collect it and trigger the next.
+ * A busy sensor NAKs, so an aborted read is retried on the next call and the
+ * measurement restarted after READ_TRIES. Readers get the last good distance
+ * and its age from a single atomic, so they never touch the bus either.
+ */
 class LidarI2C : public Lidar
 {
 public:
-	LidarI2C(I2C::Port port, char address);
-	virtual double getDistance();
+	static const uint8_t DEFAULT_ADDRESS = 0x62;
+	static const int READ_TRIES = 5;
+	static const double MEASURE_SECONDS; //a Lidar-Lite acquisition takes up to 20 ms
+
+	explicit LidarI2C(std::unique_ptr<I2CDevice> device);
+
+	void update(double now); //call once per loop, or from the thread that owns the bus
+
+	//the two halves of update(), for I2CBusScheduler to interleave several sensors
+	bool trigger(double now); //false if the sensor didn't acknowledge
+	bool collect(double now); //true when a reading was published, gives up after READ_TRIES NAKs
+	bool isMeasuring() const;
+	double readyAt() const;   //when the measurement in progress can be collected
+
+	//moves a sensor answering at the default address to address until it is powered off, only that sensor may be powered
+	static bool changeAddress(I2CDevice &device, uint8_t address);
+
+	virtual double getDistance(); //centimeters, 0 before the first reading
+	double getAge(double now) const; //seconds since the last good reading, infinite before the first
 	virtual double PIDGet();
 	virtual ~LidarI2C();
 private:
-	I2C *lidar;
-	void readyUp();
+	enum class Phase
+	{
+		Trigger,
+		Collect
+	};
+
+	void publish(uint16_t centimeters, double now);
+
+	std::unique_ptr<I2CDevice> device;
+	Phase phase;
+	double triggeredAt;
+	int readTries;
+	std::array<uint8_t, 2> buffer;
+	std::atomic<uint64_t> reading; //valid bit, centimeters and microsecond timestamp packed so readers can't see a torn pair
+	const Telemetry::Channel abortChannel;
 	/**
 	 * Pin 1 - 5v
 	 * Pin 2 - Power en - Digital output - turn off sensor (low) turn on sensor (high)
@@ -1,51 +1,53 @@
 #include "LidarPWM.hpp"
 
+const int LidarPWM::SAMPLES_TO_AVERAGE;
+const double LidarPWM::STALE_SECONDS = 0.1;
+const double LidarPWM::RESTART_SECONDS = 0.5;
+
+namespace
+{
+	const double CENTIMETERS_PER_SECOND = 1e5; //10 us of pulse per centimeter
+}
+
 LidarPWM::LidarPWM(uint32_t channelPulseLength, uint32_t channelSensorManagement, uint32_t channelResistorLine)
 	: pulseLength(channelPulseLength)
 	, sensorManagement(channelSensorManagement)
 	, resistorLine(channelResistorLine)
-	, movingAverage(12)
+	, pulseWidth(&pulseLength)
+	, lastDistance(0)
+	, lastRestart(0)
 {
+	pulseWidth.SetSemiPeriodMode(true); //time the high part of each pulse
+	pulseWidth.SetSamplesToAverage(SAMPLES_TO_AVERAGE);
+	pulseWidth.SetMaxPeriod(STALE_SECONDS);
 	sensorManagement.Set(1);
 	resistorLine.Set(0);
 }
 
 double LidarPWM::getDistance() //returns distance in centimeters
 {
-	Timer timer;
-	timer.Start();
-	while (!pulseLength.Get()) {
-		if (timer.Get() > 0.01) return computedMA;
+	double width = pulseWidth.GetPeriod();
+	if (pulseWidth.GetStopped() || width <= 0)
+	{
+		restart();
+		return lastDistance.load();
 	}
-	timer.Stop();
-	timer.Reset();
-
-	auto start = std::chrono::high_resolution_clock::now();
 
-	timer.Start();
-	while (pulseLength.Get()) {
-		if (timer.Get() > 0.01) return computedMA;
-	}
-	timer.Stop();
-
-	auto stop = std::chrono::high_resolution_clock::now();
-	auto duration = stop - start;
-	auto microseconds = std::chrono::duration_cast<std::chrono::duration<int, std::micro>>(duration);
-
-	double dist = microseconds.count() / 10;
-
-	if (dist == 0) return restart();
-
-	movingAverage.giveRawValue(dist);
-	return movingAverage.computeAverage();
+	double distance = width * CENTIMETERS_PER_SECOND;
+	lastDistance.store(distance);
+	return distance;
 }
 
-double LidarPWM::restart()
+//power cycles the sensor, at most once per RESTART_SECONDS however many threads are reading
+void LidarPWM::restart()
 {
+	double now = Timer::GetFPGATimestamp();
+	double last = lastRestart.load();
+	if (now - last < RESTART_SECONDS || !lastRestart.compare_exchange_strong(last, now))
+		return;
+
 	sensorManagement.Set(0);
-	//::Wait(0.004);
 	sensorManagement.Set(1);
-	return computedMA;
 }
 
 double LidarPWM::PIDGet()
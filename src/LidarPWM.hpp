@@ -2,28 +2,36 @@
 #define LIDAR_PWM
 
 #include <wpilib.h>
-#include <iostream>
-#include <chrono>
+#include <atomic>
 #include "Lidar.hpp"
-#include "MovingAverage.hpp"
-#include <deque>
 
+/**
+ * Lidar-Lite read from its PWM output, 10 us of high pulse per centimeter.
+ * The pulse is timed by a Counter in semi-period mode, so the FPGA measures
+ * and averages the pulses and getDistance() is a register read that never
+ * waits on the sensor and is safe from the PID thread.
+ */
 class LidarPWM : public Lidar
 {
 public:
+	static const int SAMPLES_TO_AVERAGE = 12; //pulses averaged by the FPGA, at most 127
+	static const double STALE_SECONDS;        //no pulse for this long and the sensor is restarted
+	static const double RESTART_SECONDS;      //time the sensor gets to come back before another restart
+
 	LidarPWM(uint32_t channelPulseLength, uint32_t channelSensorManagement, uint32_t channelResistorLine);
-	virtual double getDistance();
+	virtual double getDistance(); //centimeters, the last good reading while the sensor isn't pulsing
 	virtual double PIDGet();
 	virtual ~LidarPWM();
 private:
-	double restart();
+	void restart();
 
 	DigitalInput pulseLength;
 	DigitalOutput sensorManagement;
 	DigitalOutput resistorLine;
-	MovingAverage<double> movingAverage;
+	Counter pulseWidth;
+	std::atomic<double> lastDistance;
+	std::atomic<double> lastRestart;
 
-	double computedMA;
 	/**
 	 * Pin 1 - 5v
 	 * Pin 2 - Power en - Digital output - turn off sensor (low) turn on sensor (high)
@@ -0,0 +1,135 @@
+#include "MotionProfile.hpp"
+#include <algorithm>
+#include <cmath>
+
+MotionProfile::MotionProfile()
+	: count(1)
+	, period(0.01f)
+	, distance(0)
+{
+	samples[0].position = 0;
+	samples[0].velocity = 0;
+	samples[0].acceleration = 0;
+}
+
+bool MotionProfile::generate(float distance, float maxVelocity, float maxAcceleration, float maxJerk, float period)
+{
+	const float direction = distance < 0 ? -1.f : 1.f;
+	const float length = std::abs(distance);
+	maxVelocity = std::abs(maxVelocity);
+	maxAcceleration = std::abs(maxAcceleration);
+
+	this->period = period;
+	this->distance = distance;
+	count = 1;
+	samples[0].position = 0;
+	samples[0].velocity = 0;
+	samples[0].acceleration = 0;
+
+	if (length == 0 || maxVelocity == 0 || maxAcceleration == 0)
+		return length == 0;
+
+	//trapezoid, or triangle when there is no room to reach maxVelocity
+	float peakVelocity = maxVelocity;
+	if (maxVelocity * maxVelocity / maxAcceleration > length)
+		peakVelocity = std::sqrt(length * maxAcceleration);
+	const float accelTime = peakVelocity / maxAcceleration;
+	const float cruiseTime = (length - peakVelocity * accelTime) / peakVelocity;
+	const float totalTime = 2 * accelTime + cruiseTime;
+
+	//an S-curve is the trapezoid's velocity averaged over the time it takes to ramp acceleration
+	//when the cruise is shorter than the ramp, speeding up and slowing down overlap and need twice the ramp
+	int window = 1;
+	if (maxJerk > 0)
+	{
+		float rampTime = maxAcceleration / std::abs(maxJerk);
+		if (cruiseTime < rampTime)
+			rampTime *= 2;
+		window = std::max(1, static_cast<int>(std::round(rampTime / period)));
+	}
+
+	const int trapezoidSamples = static_cast<int>(std::ceil(totalTime / period)) + 1;
+	count = trapezoidSamples + window - 1;
+	if (count > MAX_SAMPLES)
+	{
+		count = 1;
+		return false;
+	}
+
+	//samples[i].velocity temporarily holds the trapezoid, then is replaced by its running average
+	for (int i = 0; i < trapezoidSamples; i++)
+	{
+		float t = i * period;
+		float v;
+		if (t < accelTime)
+			v = maxAcceleration * t;
+		else if (t < accelTime + cruiseTime)
+			v = peakVelocity;
+		else
+			v = std::max(0.f, peakVelocity - maxAcceleration * (t - accelTime - cruiseTime));
+		samples[i].acceleration = v;
+	}
+	for (int i = trapezoidSamples; i < count; i++)
+		samples[i].acceleration = 0;
+
+	float windowSum = 0;
+	for (int i = 0; i < count; i++)
+	{
+		windowSum += samples[i].acceleration;
+		if (i >= window)
+			windowSum -= samples[i - window].acceleration;
+		samples[i].velocity = windowSum / window;
+	}
+	samples[count - 1].velocity = 0;
+
+	samples[0].position = 0;
+	for (int i = 1; i < count; i++)
+		samples[i].position = samples[i - 1].position + (samples[i - 1].velocity + samples[i].velocity) / 2 * period;
+
+	//discretization leaves the end a hair off the requested distance
+	const float scale = samples[count - 1].position > 0 ? length / samples[count - 1].position : 1.f;
+	for (int i = 0; i < count; i++)
+	{
+		samples[i].position *= scale * direction;
+		samples[i].velocity *= scale * direction;
+	}
+	for (int i = 0; i < count - 1; i++)
+		samples[i].acceleration = (samples[i + 1].velocity - samples[i].velocity) / period;
+	samples[count - 1].acceleration = 0;
+
+	return true;
+}
+
+const ProfileSample& MotionProfile::sampleAt(float seconds) const
+{
+	if (seconds <= 0)
+		return samples[0];
+
+	int index = static_cast<int>(seconds / period);
+	return samples[std::min(index, count - 1)];
+}
+
+const ProfileSample& MotionProfile::getSample(int index) const
+{
+	return samples[index];
+}
+
+int MotionProfile::size() const
+{
+	return count;
+}
+
+float MotionProfile::getDuration() const
+{
+	return (count - 1) * period;
+}
+
+float MotionProfile::getDistance() const
+{
+	return distance;
+}
+
+float MotionProfile::getPeriod() const
+{
+	return period;
+}
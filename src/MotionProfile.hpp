@@ -0,0 +1,42 @@
+#ifndef MOTION_PROFILE_HPP
+#define MOTION_PROFILE_HPP
+
+#include <array>
+
+struct ProfileSample
+{
+	float position;
+	float velocity;
+	float acceleration;
+};
+
+/**
+ * Time-indexed trapezoidal or S-curve motion profile.
+ * The table is filled once by generate() and looked up in constant time
+ * by sampleAt(); the storage is fixed so nothing is allocated.
+ */
+class MotionProfile
+{
+public:
+	static const int MAX_SAMPLES = 1000;
+
+	MotionProfile();
+
+	//maxJerk of 0 gives a trapezoid, anything else an S-curve
+	bool generate(float distance, float maxVelocity, float maxAcceleration, float maxJerk, float period);
+	const ProfileSample& sampleAt(float seconds) const;
+	const ProfileSample& getSample(int index) const;
+
+	int size() const;
+	float getDuration() const;
+	float getDistance() const;
+	float getPeriod() const;
+
+private:
+	std::array<ProfileSample, MAX_SAMPLES> samples;
+	int count;
+	float period;
+	float distance;
+};
+
+#endif
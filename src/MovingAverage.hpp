@@ -0,0 +1,78 @@
+#ifndef MOVING_AVERAGE_HPP
+#define MOVING_AVERAGE_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Average of the last length values.
+ * The window is a ring buffer sized once in the constructor and the sum is kept
+ * running, so both calls are O(1) and never allocate. The sum is recomputed each
+ * time the ring wraps, so floating point error can't build up over a match.
+ */
+template <typename T>
+class MovingAverage
+{
+public:
+	explicit MovingAverage(std::size_t length)
+		: window(length > 0 ? length : 1)
+		, next(0)
+		, count(0)
+		, sum()
+	{
+	}
+
+	void giveRawValue(T value)
+	{
+		if (count == window.size())
+			sum -= window[next];
+		else
+			count++;
+
+		window[next] = value;
+		sum += value;
+
+		if (++next == window.size())
+		{
+			next = 0;
+			resum();
+		}
+	}
+
+	T computeAverage() const
+	{
+		return count == 0 ? T() : sum / static_cast<T>(count);
+	}
+
+	void reset()
+	{
+		next = 0;
+		count = 0;
+		sum = T();
+	}
+
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	std::size_t length() const
+	{
+		return window.size();
+	}
+
+private:
+	void resum()
+	{
+		sum = T();
+		for (std::size_t i = 0; i < count; i++)
+			sum += window[i];
+	}
+
+	std::vector<T> window;
+	std::size_t next;
+	std::size_t count;
+	T sum;
+};
+
+#endif
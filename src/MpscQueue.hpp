@@ -0,0 +1,80 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Lock-free bounded queue for handing values from any number of producer
+ * threads to exactly one consumer thread. Each slot carries a sequence
+ * number saying whether it is free, being written or ready to read, so
+ * producers only contend on a single compare-and-swap. Capacity must be a
+ * power of two.
+ */
+template <typename T, std::size_t Capacity>
+class MpscQueue
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "MpscQueue capacity must be a power of two");
+
+public:
+	MpscQueue()
+		: tail(0)
+		, head(0)
+	{
+		for (std::size_t i = 0; i < Capacity; i++)
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	bool push(const T& value) //any thread, returns false when full
+	{
+		std::size_t position = tail.load(std::memory_order_relaxed);
+		Slot *slot;
+		for (;;)
+		{
+			slot = &slots[position & (Capacity - 1)];
+			std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+			if (difference == 0)
+			{
+				if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (difference < 0)
+				return false;
+			else
+				position = tail.load(std::memory_order_relaxed);
+		}
+
+		slot->value = value;
+		slot->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T& value) //consumer only, returns false when empty
+	{
+		Slot &slot = slots[head & (Capacity - 1)];
+		std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != head + 1)
+			return false;
+
+		value = slot.value;
+		slot.sequence.store(head + Capacity, std::memory_order_release);
+		head++;
+		return true;
+	}
+
+private:
+	struct Slot
+	{
+		std::atomic<std::size_t> sequence;
+		T value;
+	};
+
+	std::array<Slot, Capacity> slots;
+	std::atomic<std::size_t> tail;
+	std::size_t head;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#include "Odometry.hpp"
+#include <cmath>
+
+namespace
+{
+	const float DEGREES_TO_RADIANS = 3.14159265f / 180.f;
+}
+
+Pose relativePose(const Pose &pose, const Pose &origin)
+{
+	float angle = origin.heading * DEGREES_TO_RADIANS;
+	float dx = pose.x - origin.x;
+	float dy = pose.y - origin.y;
+	Pose relative;
+	relative.x = std::cos(angle) * dx + std::sin(angle) * dy;
+	relative.y = -std::sin(angle) * dx + std::cos(angle) * dy;
+	relative.heading = pose.heading - origin.heading;
+	return relative;
+}
+
+Odometry::Odometry()
+	: lastLeft(0)
+	, lastRight(0)
+	, headingOffset(0)
+{
+	pose.x = 0;
+	pose.y = 0;
+	pose.heading = 0;
+}
+
+void Odometry::reset(float leftDistance, float rightDistance, float heading)
+{
+	pose.x = 0;
+	pose.y = 0;
+	pose.heading = 0;
+	lastLeft = leftDistance;
+	lastRight = rightDistance;
+	headingOffset = heading;
+}
+
+void Odometry::update(float leftDistance, float rightDistance, float heading)
+{
+	float distance = ((leftDistance - lastLeft) + (rightDistance - lastRight)) / 2;
+	lastLeft = leftDistance;
+	lastRight = rightDistance;
+
+	//integrate along the average of the old and new heading
+	float newHeading = heading - headingOffset;
+	float middle = (pose.heading + newHeading) / 2 * DEGREES_TO_RADIANS;
+	pose.x += distance * std::cos(middle);
+	pose.y += distance * std::sin(middle);
+	pose.heading = newHeading;
+}
+
+const Pose& Odometry::getPose() const
+{
+	return pose;
+}
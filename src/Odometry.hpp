@@ -0,0 +1,34 @@
+#ifndef ODOMETRY_HPP
+#define ODOMETRY_HPP
+
+//x is forward and y is to the left of where the pose was reset, in inches; heading is counterclockwise degrees
+struct Pose
+{
+	float x;
+	float y;
+	float heading;
+};
+
+Pose relativePose(const Pose &pose, const Pose &origin); //pose as seen from a robot sitting at origin
+
+/**
+ * Dead reckoning from the drive encoders and gyro.
+ * Distance comes from the average of the encoders, direction from the gyro.
+ */
+class Odometry
+{
+public:
+	Odometry();
+
+	void reset(float leftDistance, float rightDistance, float heading);
+	void update(float leftDistance, float rightDistance, float heading);
+	const Pose& getPose() const;
+
+private:
+	Pose pose;
+	float lastLeft;
+	float lastRight;
+	float headingOffset;
+};
+
+#endif
@@ -0,0 +1,183 @@
+#include "PathPlanner.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const int SAMPLES_PER_SEGMENT = 200;
+	const float DEGREES_TO_RADIANS = 3.14159265f / 180.f;
+
+	//power basis coefficients of a quintic Hermite spline with zero end accelerations
+	void hermiteCoefficients(float p0, float v0, float p1, float v1, float c[6])
+	{
+		c[0] = p0;
+		c[1] = v0;
+		c[2] = 0;
+		c[3] = -10 * p0 - 6 * v0 - 4 * v1 + 10 * p1;
+		c[4] = 15 * p0 + 8 * v0 + 7 * v1 - 15 * p1;
+		c[5] = -6 * p0 - 3 * v0 - 3 * v1 + 6 * p1;
+	}
+
+	float position(const float c[6], float t)
+	{
+		return c[0] + t * (c[1] + t * (c[2] + t * (c[3] + t * (c[4] + t * c[5]))));
+	}
+
+	float firstDerivative(const float c[6], float t)
+	{
+		return c[1] + t * (2 * c[2] + t * (3 * c[3] + t * (4 * c[4] + t * 5 * c[5])));
+	}
+
+	float secondDerivative(const float c[6], float t)
+	{
+		return 2 * c[2] + t * (6 * c[3] + t * (12 * c[4] + t * 20 * c[5]));
+	}
+}
+
+PathPlanner::PathPlanner(float trackWidth, float maxVelocity, float maxAcceleration, float maxJerk, float period)
+	: trackWidth(trackWidth)
+	, maxVelocity(maxVelocity)
+	, maxAcceleration(maxAcceleration)
+	, maxJerk(maxJerk)
+	, period(period)
+{
+}
+
+void PathPlanner::sampleSegment(const Waypoint &from, const Waypoint &to, std::vector<PathPoint> &points) const
+{
+	//tangents scaled to the chord length keep the curve from looping or flattening out
+	float chord = std::hypot(to.x - from.x, to.y - from.y);
+	float h0 = from.heading * DEGREES_TO_RADIANS;
+	float h1 = to.heading * DEGREES_TO_RADIANS;
+
+	float cx[6], cy[6];
+	hermiteCoefficients(from.x, chord * std::cos(h0), to.x, chord * std::cos(h1), cx);
+	hermiteCoefficients(from.y, chord * std::sin(h0), to.y, chord * std::sin(h1), cy);
+
+	float distance = points.empty() ? 0 : points.back().distance;
+	float lastSpeed = chord;
+	for (int i = points.empty() ? 0 : 1; i <= SAMPLES_PER_SEGMENT; i++)
+	{
+		float t = static_cast<float>(i) / SAMPLES_PER_SEGMENT;
+		float dx = firstDerivative(cx, t), dy = firstDerivative(cy, t);
+		float ddx = secondDerivative(cx, t), ddy = secondDerivative(cy, t);
+		float speed = std::hypot(dx, dy);
+
+		if (i > 0)
+			distance += (speed + lastSpeed) / 2 / SAMPLES_PER_SEGMENT;
+		lastSpeed = speed;
+
+		PathPoint point;
+		point.x = position(cx, t);
+		point.y = position(cy, t);
+		point.distance = distance;
+		point.heading = std::atan2(dy, dx);
+		point.curvature = speed > 0 ? (dx * ddy - dy * ddx) / (speed * speed * speed) : 0;
+		points.push_back(point);
+	}
+}
+
+bool PathPlanner::samplePath(const std::vector<Waypoint> &waypoints, std::vector<PathPoint> &points) const
+{
+	if (waypoints.size() < 2)
+		return false;
+
+	points.reserve((waypoints.size() - 1) * SAMPLES_PER_SEGMENT + 1);
+	for (std::size_t i = 0; i + 1 < waypoints.size(); i++)
+		sampleSegment(waypoints[i], waypoints[i + 1], points);
+	return true;
+}
+
+//evenly spaced points along the spline for PurePursuit
+bool PathPlanner::planPoints(const std::vector<Waypoint> &waypoints, float spacing, std::vector<PursuitPoint> &path) const
+{
+	std::vector<PathPoint> points;
+	if (spacing <= 0 || !samplePath(waypoints, points))
+		return false;
+
+	path.clear();
+	float next = 0;
+	for (std::size_t i = 0; i + 1 < points.size(); i++)
+	{
+		const PathPoint &a = points[i], &b = points[i + 1];
+		while (next <= b.distance)
+		{
+			float span = b.distance - a.distance;
+			float blend = span > 0 ? (next - a.distance) / span : 0;
+			PursuitPoint point = { a.x + (b.x - a.x) * blend, a.y + (b.y - a.y) * blend };
+			path.push_back(point);
+			next += spacing;
+		}
+	}
+
+	//the end of the path always gets a point, unless spacing already landed one there
+	PursuitPoint end = { points.back().x, points.back().y };
+	if (next - spacing < points.back().distance - spacing / 100)
+		path.push_back(end);
+	return true;
+}
+
+bool PathPlanner::plan(const std::vector<Waypoint> &waypoints, Trajectory &trajectory) const
+{
+	std::vector<PathPoint> points;
+	if (!samplePath(waypoints, points))
+		return false;
+
+	//slow the whole path down so the outside wheel never exceeds maxVelocity in the tightest turn
+	float maxCurvature = 0;
+	for (std::size_t i = 0; i < points.size(); i++)
+		maxCurvature = std::max(maxCurvature, std::abs(points[i].curvature));
+	float centerVelocity = maxVelocity / (1 + maxCurvature * trackWidth / 2);
+
+	MotionProfile center;
+	if (!center.generate(points.back().distance, centerVelocity, maxAcceleration, maxJerk, period))
+		return false;
+
+	const float startHeading = points.front().heading;
+	trajectory.period = period;
+	trajectory.left.resize(center.size());
+	trajectory.right.resize(center.size());
+	trajectory.heading.resize(center.size());
+
+	std::size_t point = 0;
+	for (int i = 0; i < center.size(); i++)
+	{
+		const ProfileSample &sample = center.getSample(i);
+		while (point + 2 < points.size() && points[point + 1].distance < sample.position)
+			point++;
+
+		const PathPoint &a = points[point], &b = points[point + 1];
+		float span = b.distance - a.distance;
+		float blend = span > 0 ? std::min(1.f, std::max(0.f, (sample.position - a.distance) / span)) : 0;
+		float curvature = a.curvature + (b.curvature - a.curvature) * blend;
+		float heading = a.heading + std::remainder(b.heading - a.heading, 2 * 3.14159265f) * blend;
+
+		float leftScale = 1 - curvature * trackWidth / 2;
+		float rightScale = 1 + curvature * trackWidth / 2;
+		trajectory.left[i].velocity = sample.velocity * leftScale;
+		trajectory.right[i].velocity = sample.velocity * rightScale;
+		trajectory.heading[i] = std::remainder(heading - startHeading, 2 * 3.14159265f) / DEGREES_TO_RADIANS;
+
+		if (i == 0)
+		{
+			trajectory.left[i].position = 0;
+			trajectory.right[i].position = 0;
+		}
+		else
+		{
+			trajectory.left[i].position = trajectory.left[i - 1].position
+			                            + (trajectory.left[i - 1].velocity + trajectory.left[i].velocity) / 2 * period;
+			trajectory.right[i].position = trajectory.right[i - 1].position
+			                             + (trajectory.right[i - 1].velocity + trajectory.right[i].velocity) / 2 * period;
+		}
+	}
+
+	for (int i = 0; i < center.size(); i++)
+	{
+		bool last = i + 1 == center.size();
+		trajectory.left[i].acceleration = last ? 0 : (trajectory.left[i + 1].velocity - trajectory.left[i].velocity) / period;
+		trajectory.right[i].acceleration = last ? 0 : (trajectory.right[i + 1].velocity - trajectory.right[i].velocity) / period;
+	}
+
+	return true;
+}
@@ -0,0 +1,49 @@
+#ifndef PATH_PLANNER_HPP
+#define PATH_PLANNER_HPP
+
+#include <vector>
+#include "Trajectory.hpp"
+#include "PurePursuit.hpp"
+
+//x is forward and y is to the left of the starting pose, in inches; heading is in degrees
+struct Waypoint
+{
+	float x;
+	float y;
+	float heading;
+};
+
+/**
+ * Joins waypoints with quintic Hermite splines and time-parameterizes the
+ * path into left and right wheel profiles a differential drive can follow.
+ * Meant to run ahead of time or once at RobotInit; it allocates freely.
+ */
+class PathPlanner
+{
+public:
+	PathPlanner(float trackWidth, float maxVelocity, float maxAcceleration, float maxJerk, float period);
+
+	bool plan(const std::vector<Waypoint> &waypoints, Trajectory &trajectory) const;
+	bool planPoints(const std::vector<Waypoint> &waypoints, float spacing, std::vector<PursuitPoint> &path) const;
+
+private:
+	struct PathPoint
+	{
+		float x;
+		float y;
+		float distance; //arc length from the start
+		float heading;  //radians
+		float curvature;
+	};
+
+	void sampleSegment(const Waypoint &from, const Waypoint &to, std::vector<PathPoint> &points) const;
+	bool samplePath(const std::vector<Waypoint> &waypoints, std::vector<PathPoint> &points) const;
+
+	const float trackWidth;
+	const float maxVelocity;
+	const float maxAcceleration;
+	const float maxJerk;
+	const float period;
+};
+
+#endif
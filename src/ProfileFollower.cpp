@@ -0,0 +1,72 @@
+#include "ProfileFollower.hpp"
+#include <algorithm>
+#include <cmath>
+
+ProfileFollower::ProfileFollower(float kV, float kA, float kP, float kD, float tolerance, float timeout)
+	: samples(nullptr)
+	, count(0)
+	, period(0.01f)
+	, kV(kV)
+	, kA(kA)
+	, kP(kP)
+	, kD(kD)
+	, tolerance(tolerance)
+	, timeout(timeout)
+	, lastError(0)
+	, lastTime(-1)
+{
+}
+
+void ProfileFollower::start(const MotionProfile *profile)
+{
+	start(&profile->getSample(0), profile->size(), profile->getPeriod());
+}
+
+void ProfileFollower::start(const ProfileSample *samples, int count, float period)
+{
+	this->samples = samples;
+	this->count = count;
+	this->period = period;
+	lastError = 0;
+	lastTime = -1;
+}
+
+float ProfileFollower::calculate(float seconds, float position)
+{
+	if (samples == nullptr)
+		return 0;
+
+	int index = seconds > 0 ? std::min(static_cast<int>(seconds / period), count - 1) : 0;
+	const ProfileSample &target = samples[index];
+	float error = target.position - position;
+
+	float derivative = 0;
+	if (lastTime >= 0 && seconds > lastTime)
+		derivative = (error - lastError) / (seconds - lastTime);
+	lastError = error;
+	lastTime = seconds;
+
+	float output = kV * target.velocity
+	             + kA * target.acceleration
+	             + kP * error
+	             + kD * derivative;
+	return std::max(-1.f, std::min(1.f, output));
+}
+
+bool ProfileFollower::isFinished(float seconds, float position) const
+{
+	if (samples == nullptr)
+		return true;
+
+	float duration = (count - 1) * period;
+	if (seconds < duration)
+		return false;
+
+	return std::abs(samples[count - 1].position - position) < tolerance
+	    || seconds > duration + timeout;
+}
+
+float ProfileFollower::getError() const
+{
+	return lastError;
+}
@@ -0,0 +1,33 @@
+#ifndef PROFILE_FOLLOWER_HPP
+#define PROFILE_FOLLOWER_HPP
+
+#include "MotionProfile.hpp"
+
+/**
+ * Turns a table of ProfileSamples into motor outputs for one side of the
+ * drivetrain: velocity and acceleration feedforward plus PD correction on position.
+ */
+class ProfileFollower
+{
+public:
+	ProfileFollower(float kV, float kA, float kP, float kD, float tolerance, float timeout);
+
+	void start(const MotionProfile *profile);
+	void start(const ProfileSample *samples, int count, float period);
+	float calculate(float seconds, float position); //position is measured from the start of the move
+	bool isFinished(float seconds, float position) const;
+	float getError() const;
+
+private:
+	const ProfileSample *samples;
+	int count;
+	float period;
+	const float kV, kA, kP, kD;
+	const float tolerance;
+	const float timeout;
+
+	float lastError;
+	float lastTime;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#include "PurePursuit.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const float DEGREES_TO_RADIANS = 3.14159265f / 180.f;
+}
+
+PurePursuit::PurePursuit(float lookahead, float trackWidth, float maxVelocity, float maxAcceleration, float tolerance)
+	: lookahead(lookahead)
+	, trackWidth(trackWidth)
+	, maxVelocity(maxVelocity)
+	, maxAcceleration(maxAcceleration)
+	, tolerance(tolerance)
+	, path(nullptr)
+	, closest(0)
+	, target(0)
+	, velocity(0)
+	, finished(true)
+	, searchCount(0)
+{
+}
+
+void PurePursuit::start(const PursuitPath *path)
+{
+	this->path = path;
+	closest = 0;
+	target = 0;
+	velocity = 0;
+	finished = path == nullptr || path->count < 2;
+	searchCount = 0;
+}
+
+float PurePursuit::distanceSquared(const Pose &pose, int index) const
+{
+	float dx = path->points[index].x - pose.x;
+	float dy = path->points[index].y - pose.y;
+	return dx * dx + dy * dy;
+}
+
+WheelSpeeds PurePursuit::calculate(const Pose &pose, float dt)
+{
+	WheelSpeeds speeds = { 0, 0 };
+	searchCount = 0;
+	if (finished)
+		return speeds;
+
+	const int last = path->count - 1;
+
+	//closest point: walk forward while the next point is nearer
+	int limit = std::min(last, closest + SEARCH_WINDOW);
+	float best = distanceSquared(pose, closest);
+	for (int i = closest + 1; i <= limit; i++)
+	{
+		searchCount++;
+		float d = distanceSquared(pose, i);
+		if (d > best)
+			break;
+		best = d;
+		closest = i;
+	}
+
+	//lookahead point: first point at least one lookahead away, never behind the last one
+	target = std::max(target, closest);
+	limit = std::min(last, target + SEARCH_WINDOW);
+	while (target < limit && distanceSquared(pose, target) < lookahead * lookahead)
+	{
+		searchCount++;
+		target++;
+	}
+
+	//closest reaching the last point means the robot has come alongside or passed the end
+	float remaining = std::sqrt(distanceSquared(pose, last));
+	if (remaining < tolerance || closest == last)
+	{
+		finished = true;
+		velocity = 0;
+		return speeds;
+	}
+
+	//the target in robot coordinates, then the arc through it
+	float heading = pose.heading * DEGREES_TO_RADIANS;
+	float dx = path->points[target].x - pose.x;
+	float dy = path->points[target].y - pose.y;
+	float localY = -std::sin(heading) * dx + std::cos(heading) * dy;
+	float distance2 = std::max(dx * dx + dy * dy, 1e-6f);
+	float curvature = 2 * localY / distance2;
+
+	//fastest the outside wheel allows, slowing down to stop at the end of the path
+	float wanted = maxVelocity / (1 + std::abs(curvature) * trackWidth / 2);
+	wanted = std::min(wanted, std::sqrt(2 * maxAcceleration * remaining));
+	float step = maxAcceleration * dt;
+	velocity += std::max(-step, std::min(step, wanted - velocity));
+
+	speeds.left = velocity * (1 - curvature * trackWidth / 2);
+	speeds.right = velocity * (1 + curvature * trackWidth / 2);
+	return speeds;
+}
+
+bool PurePursuit::isFinished() const
+{
+	return finished;
+}
+
+int PurePursuit::getClosestIndex() const
+{
+	return closest;
+}
+
+int PurePursuit::getLastSearchCount() const
+{
+	return searchCount;
+}
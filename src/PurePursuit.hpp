@@ -0,0 +1,63 @@
+#ifndef PURE_PURSUIT_HPP
+#define PURE_PURSUIT_HPP
+
+#include "Odometry.hpp"
+
+struct PursuitPoint
+{
+	float x;
+	float y;
+};
+
+//Points a PurePursuit follows, spaced evenly; the points must outlive the follower
+struct PursuitPath
+{
+	const PursuitPoint *points;
+	int count;
+};
+
+struct WheelSpeeds
+{
+	float left;  //inches per second
+	float right;
+};
+
+/**
+ * Pure pursuit path follower for a differential drive.
+ * Each cycle it finds the closest path point and the point one lookahead
+ * distance further on, then steers along the arc that reaches it. Both
+ * searches resume from the previous cycle and look at most SEARCH_WINDOW
+ * points ahead, so a cycle costs the same no matter how long the path is.
+ */
+class PurePursuit
+{
+public:
+	static const int SEARCH_WINDOW = 32;
+
+	PurePursuit(float lookahead, float trackWidth, float maxVelocity, float maxAcceleration, float tolerance);
+
+	void start(const PursuitPath *path);
+	WheelSpeeds calculate(const Pose &pose, float dt);
+	bool isFinished() const;
+
+	int getClosestIndex() const;
+	int getLastSearchCount() const; //path points examined by the last calculate()
+
+private:
+	float distanceSquared(const Pose &pose, int index) const;
+
+	const float lookahead;
+	const float trackWidth;
+	const float maxVelocity;
+	const float maxAcceleration;
+	const float tolerance;
+
+	const PursuitPath *path;
+	int closest;
+	int target;
+	float velocity;
+	bool finished;
+	int searchCount;
+};
+
+#endif
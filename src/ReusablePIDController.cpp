@@ -0,0 +1,21 @@
+#include "ReusablePIDController.hpp"
+
+ReusablePIDController::ReusablePIDController(PIDSource *source, PIDOutput *output, float period)
+	: PIDController(0.f, 0.f, 0.f, 0.f, source, output, period)
+{
+}
+
+//clears the old integral, loads new gains and setpoint, then enables
+void ReusablePIDController::rearm(float p, float i, float d, float f, float setpoint)
+{
+	retune(p, i, d, f);
+	SetSetpoint(setpoint);
+	Enable();
+}
+
+//clears the old integral and loads new gains, leaving the controller disabled
+void ReusablePIDController::retune(float p, float i, float d, float f)
+{
+	Reset();
+	SetPID(p, i, d, f);
+}
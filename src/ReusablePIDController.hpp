@@ -0,0 +1,20 @@
+#ifndef REUSABLE_PID_CONTROLLER_HPP
+#define REUSABLE_PID_CONTROLLER_HPP
+
+#include <WPILib.h>
+#include "InstanceCounter.hpp"
+
+/**
+ * A PIDController that is built once and re-armed for every maneuver.
+ * Each PIDController owns a Notifier, so live() is also the number of
+ * PID Notifiers running in the background.
+ */
+class ReusablePIDController : public PIDController, public InstanceCounter<ReusablePIDController>
+{
+public:
+	ReusablePIDController(PIDSource *source, PIDOutput *output, float period = 0.05f);
+	void rearm(float p, float i, float d, float f, float setpoint);
+	void retune(float p, float i, float d, float f);
+};
+
+#endif
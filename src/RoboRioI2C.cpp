@@ -0,0 +1,16 @@
+#include "RoboRioI2C.hpp"
+
+RoboRioI2C::RoboRioI2C(I2C::Port port, uint8_t address)
+	: i2c(port, address)
+{
+}
+
+bool RoboRioI2C::write(uint8_t registerAddress, uint8_t data)
+{
+	return i2c.Write(registerAddress, data);
+}
+
+bool RoboRioI2C::read(uint8_t registerAddress, uint8_t count, uint8_t *buffer)
+{
+	return i2c.Read(registerAddress, count, buffer);
+}
@@ -0,0 +1,19 @@
+#ifndef ROBORIO_I2C_HPP
+#define ROBORIO_I2C_HPP
+
+#include <WPILib.h>
+#include "I2CDevice.hpp"
+
+//a device on one of the roboRIO's I2C ports
+class RoboRioI2C : public I2CDevice
+{
+public:
+	RoboRioI2C(I2C::Port port, uint8_t address);
+	virtual bool write(uint8_t registerAddress, uint8_t data);
+	virtual bool read(uint8_t registerAddress, uint8_t count, uint8_t *buffer);
+
+private:
+	I2C i2c;
+};
+
+#endif
@@ -13,15 +13,54 @@
 #include "ToteLifter.hpp"
 #include "JoyTest.hpp"
 #include "ContainerLifter.hpp"
-
-void createButtonMapping(bool down, bool pressed, bool up,
-						 ButtonNames buttonName,
-						 std::function<void()> callback,
-						 ActionMap &map)
+#include "TrajectoryCache.hpp"
+#include "AutoPaths.hpp"
+#include "Telemetry.hpp"
+#include "LatencyTracer.hpp"
+#include "InputRecording.hpp"
+#include "ButtonConfig.hpp"
+#include <fstream>
+#include <sstream>
+
+//run DriveAuto on its own thread at a steady rate instead of once per driver station packet
+const bool THREADED_DRIVE_AUTO = false;
+const double DRIVE_AUTO_RATE = 200; //Hz
+
+//teach-in autonomous: record the driver's sticks in teleop and play them back in autonomous
+const bool RECORD_TELEOP = true;
+const bool REPLAY_IN_AUTONOMOUS = false;
+const char* const TEACH_IN_FILE = "/home/lvuser/teleop.inputs";
+
+//controls, edited on the robot and picked up while disabled
+const char* const BUTTONS_FILE = "/home/lvuser/buttons.cfg";
+const int BUTTONS_CHECK_LOOPS = 50; //disabled loops between checks for an edited file
+const char* const DEFAULT_BUTTONS =
+	"# <device> <button>[+<button>] <down|pressed|up|while|held seconds> <command>\n"
+	"# lifter commands last one loop, so they are bound while held\n"
+	"joystick BottomRight while lifter.down\n"
+	"joystick TopRight    while lifter.up\n"
+	"joystick Button7     down shifter.low\n"
+	"joystick Button8     down shifter.high\n"
+	"joystick Button11    down container.extend\n"
+	"joystick Button12    down container.retract\n"
+	"gamecube BottomRight while lifter.up        # y\n"
+	"gamecube SideButton  while lifter.down      # b\n"
+	"gamecube Button10    down drive.panic       # d-pad down\n"
+	"gamecube Trigger     down container.extend  # a\n"
+	"gamecube BottomLeft  down container.retract # x\n"
+	"gamecube Button9     while lifter.override  # d-pad up\n"
+	"gamecube Button8     down drive.forwardOnly # start\n"
+	"gamecube TopLeft     down drive.zeroMotors  # z\n";
+
+//tags path as driven by this packet before running callback, so the output it leads to gets timed
+template <typename F>
+Action<void()>::Callback traced(LatencyPath path, F callback)
 {
-	JoyButton button(down, pressed, up, buttonName);
-	Action<void()> action(callback, 0);
-	map.associate(button, action);
+	return [path, callback]()
+	{
+		LatencyTracer::get()->tag(path);
+		callback();
+	};
 }
 
 class Robot : public IterativeRobot
@@ -35,94 +74,75 @@ private:
 	//LidarI2C *Lidar;
 	ContainerLifter cLifter;
 	Timer timer;
+	TrajectoryCache trajectories;
+	std::vector<PursuitPoint> sweepPoints;
+	PursuitPath sweepPath;
+	InputRecorder inputRecorder;
+	InputPlayer inputPlayer;
+	bool replaying;
+	ButtonConfig buttonConfig;
+	int disabledLoops;
 
 public:
-	Robot() : shifter(0, 1), cLifter(2, 3)
+	Robot() : shifter(0, 1), cLifter(2, 3), inputRecorder(relay.getAttached()), replaying(false), disabledLoops(0)
 	{
 
 	}
 
 	void RobotInit()
 	{
-		auto &joyMap = relay.getMapJoy();
-		auto &gcnMap = relay.getMapGCN();
-
-		createButtonMapping(true, false, false
-				          , ButtonNames::BottomRight
-						  , std::bind(&ToteLifter::manualDown, &lifter)
-						  , joyMap);
-
-		createButtonMapping(true, false, false
-						  , ButtonNames::TopRight
-						  , std::bind(&ToteLifter::manualUp, &lifter)
-						  , joyMap);
-
-		createButtonMapping(true, false, false
-						  , ButtonNames::Button7
-						  , std::bind(&Shifter::shiftLow, &shifter)
-						  , joyMap);
-
-		createButtonMapping(true, false, false
-						  , ButtonNames::Button8
-						  , std::bind(&Shifter::shiftHigh, &shifter)
-						  , joyMap);
-
-		createButtonMapping(true, false, false
-						  , ButtonNames::Button11
-						  , std::bind(&ContainerLifter::extendPiston, &cLifter)
-						  , joyMap);
-
-		createButtonMapping(true, false, false
-						  , ButtonNames::Button12
-						  , std::bind(&ContainerLifter::retractPiston, &cLifter)
-						  , joyMap);
-
-		//y
-		createButtonMapping(false, true, false
-						  , ButtonNames::BottomRight
-						  , std::bind(&ToteLifter::manualUp, &lifter)
-						  , gcnMap);
-
-		//b
-		createButtonMapping(false, true, false
-					      , ButtonNames::SideButton
-					      , std::bind(&ToteLifter::manualDown, &lifter)
-						  , gcnMap);
-		//down
-		createButtonMapping(true, false, false
-					      , ButtonNames::Button10
-						  , std::bind(&DriveAuto::panic, DriveAuto::get())
-						  , gcnMap);
-
-		//a
-		createButtonMapping(true, false, false
-						  , ButtonNames::Trigger
-						  , std::bind(&ContainerLifter::extendPiston, &cLifter)
-						  , gcnMap);
-
-		//x
-		createButtonMapping(true, false, false
-						  , ButtonNames::BottomLeft
-						  , std::bind(&ContainerLifter::retractPiston, &cLifter)
-						  , gcnMap);
-
-		//up
-		createButtonMapping(true, false, false
-						, ButtonNames::Button9
-						, std::bind(&ToteLifter::limitOverride, &lifter)
-						, gcnMap);
-
-		//start
-		createButtonMapping(true, false, false
-						, ButtonNames::Button8
-						, std::bind(&EventRelay::setFBGCN, &relay)
-						, gcnMap);
-
-		//z
-		createButtonMapping(true, false, false
-						, ButtonNames::TopLeft
-						, std::bind(&EventRelay::zeroMotors, &relay)
-						, gcnMap);
+		Telemetry::get()->start(std::cout);
+		RobotLocation::get()->startSampling();
+
+		//planning is slow on the roboRIO, so only redo it when the paths or planner constants have changed
+		if (!trajectories.open(AutoPaths::CACHE_FILE) || trajectories.getSourceHash() != AutoPaths::sourceHash())
+		{
+			std::cout << "Planning autonomous trajectories" << std::endl;
+			TrajectoryCache::write(AutoPaths::CACHE_FILE, AutoPaths::build(), AutoPaths::sourceHash());
+			trajectories.open(AutoPaths::CACHE_FILE);
+		}
+		sweepPoints = AutoPaths::buildSweepPursuit();
+		sweepPath.points = sweepPoints.data();
+		sweepPath.count = sweepPoints.size();
+
+		buttonConfig.addDevice("joystick", EventRelay::JOYSTICK_PORT);
+		buttonConfig.addDevice("gamecube", EventRelay::GAMECUBE_PORT);
+		buttonConfig.addCommand("lifter.up", traced(LatencyPath::Lifter, std::bind(&ToteLifter::manualUp, &lifter)));
+		buttonConfig.addCommand("lifter.down", traced(LatencyPath::Lifter, std::bind(&ToteLifter::manualDown, &lifter)));
+		buttonConfig.addCommand("lifter.override", std::bind(&ToteLifter::limitOverride, &lifter));
+		buttonConfig.addCommand("shifter.low", traced(LatencyPath::Shifter, std::bind(&Shifter::shiftLow, &shifter)));
+		buttonConfig.addCommand("shifter.high", traced(LatencyPath::Shifter, std::bind(&Shifter::shiftHigh, &shifter)));
+		buttonConfig.addCommand("container.extend", std::bind(&ContainerLifter::extendPiston, &cLifter));
+		buttonConfig.addCommand("container.retract", std::bind(&ContainerLifter::retractPiston, &cLifter));
+		buttonConfig.addCommand("drive.panic", std::bind(&DriveAuto::panic, DriveAuto::get()));
+		buttonConfig.addCommand("drive.forwardOnly", std::bind(&EventRelay::setFBGCN, &relay));
+		buttonConfig.addCommand("drive.zeroMotors", std::bind(&EventRelay::zeroMotors, &relay));
+
+		//first boot writes the defaults out so there is a file to edit
+		std::ifstream existing(BUTTONS_FILE);
+		if (!existing)
+			std::ofstream(BUTTONS_FILE) << DEFAULT_BUTTONS;
+		if (!reloadButtons())
+		{
+			std::istringstream defaults(DEFAULT_BUTTONS);
+			std::vector<std::string> errors;
+			relay.setBindings(buttonConfig.build(defaults, errors));
+		}
+	}
+
+	//builds a new dispatch table from BUTTONS_FILE and swaps it in, keeps the old one if the file has errors
+	bool reloadButtons()
+	{
+		std::vector<std::string> errors;
+		std::unique_ptr<InputBus> bindings = buttonConfig.load(BUTTONS_FILE, errors);
+		for (const std::string &error : errors)
+			std::cout << BUTTONS_FILE << " " << error << std::endl;
+		if (!bindings)
+			return false;
+
+		relay.setBindings(std::move(bindings));
+		std::cout << "Loaded button bindings from " << BUTTONS_FILE << std::endl;
+		return true;
 	}
 
 	void AutonomousInit()
@@ -138,7 +158,14 @@ public:
 		DriveAuto::get()->wait(1);
 		DriveAuto::get()->move(100, 0.75);
 		*/
+		RobotLocation::get()->resetPose();
+		if (THREADED_DRIVE_AUTO)
+			DriveAuto::get()->startControlThread(DRIVE_AUTO_RATE);
+
 		shifter.shiftLow();
+		replaying = REPLAY_IN_AUTONOMOUS && inputPlayer.open(TEACH_IN_FILE);
+		if (replaying)
+			relay.replay(&inputPlayer, Timer::GetFPGATimestamp());
 		//Timer timer;
 		//timer.Start();
 		//DriveAuto::get()->wait(2.0);
@@ -148,6 +175,8 @@ public:
 		//DriveAuto::get()->wait(2.0);
 		//cLifter.retractPiston();
 		//DriveAuto::get()->move(5, 0.5);
+		//DriveAuto::get()->followTrajectory(trajectories.find("AutoZone"));
+		//DriveAuto::get()->followPath(&sweepPath);
 		std::cout << "cat" << std::endl;
 		//DriveAuto::get()->getLeftMotors()->Set(0.6);
 		//DriveAuto::get()->getRightMotors()->Set(0.6);
@@ -161,20 +190,39 @@ public:
 			cLifter.retractPiston();
 		}
 		*/
-		DriveAuto::get()->update();
+		if (replaying)
+		{
+			relay.checkStates(Timer::GetFPGATimestamp());
+			lifter.update();
+		}
+		else if (!DriveAuto::get()->isThreaded())
+			DriveAuto::get()->update();
 	}
 
 	void TeleopInit()
 	{
 		RobotLocation::get()->getLeftEncoder()->Reset();
 		RobotLocation::get()->getRightEncoder()->Reset();
+		DriveAuto::get()->stopControlThread();
 		DriveAuto::get()->panic();
 		shifter.shiftLow();
+
+		relay.replay(nullptr, 0);
+		replaying = false;
+		if (RECORD_TELEOP)
+		{
+			inputRecorder.clear();
+			relay.record(&inputRecorder);
+		}
 	}
 
 	void TeleopPeriodic()
 	{
-		relay.checkStates();
+		//IterativeRobot runs this as soon as a new driver station packet is in
+		double now = Timer::GetFPGATimestamp();
+		LatencyTracer::get()->packetArrived(now);
+		relay.checkStates(now);
+		RobotLocation::get()->filterSensors();
 		shifter.shiftUpdate();
 		lifter.update();
 		//std::cout << "left" << RobotLocation::get()->getLeftEncoder()->GetDistance() << std::endl;
@@ -183,12 +231,23 @@ public:
 
 	void DisabledInit()
 	{
+		DriveAuto::get()->stopControlThread();
+		LatencyTracer::get()->report();
+
+		relay.record(nullptr);
+		if (inputRecorder.full())
+			std::cout << "Input recording filled up after " << inputRecorder.frames() << " frames" << std::endl;
+		if (inputRecorder.frames() > 0)
+			inputRecorder.write(TEACH_IN_FILE);
+		inputRecorder.clear();
 
 	}
 
 	void DisabledPeriodic()
 	{
-
+		//controls can only change while disabled, so TeleopPeriodic never waits on a reload
+		if (++disabledLoops % BUTTONS_CHECK_LOOPS == 0 && buttonConfig.changed(BUTTONS_FILE))
+			reloadButtons();
 	}
 };
 
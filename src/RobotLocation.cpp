@@ -1,5 +1,6 @@
 #include <WPILib.h>
 #include "RobotLocation.hpp"
+#include "DriveConstants.hpp"
 #include <iostream>
 #include <cmath>
 
@@ -17,12 +18,83 @@ RobotLocation::RobotLocation()
 	  : gyro(new  Gyro(5))
 	  , left(new Encoder(0, 1, true))
 	  , right(new Encoder(2, 3, true))
+	  , sensorFilters(3, DriveConstants::RATE_AVERAGE_SAMPLES, 1)
+	  , sampler(DriveConstants::SAMPLER_RATE)
 	  //, north(new LidarPWM(4, 5, 6))
-	  //, east(new LidarI2C(I2C::Port::kMXP, 0x62))
+	  //, east(new LidarI2C(std::unique_ptr<I2CDevice>(new RoboRioI2C(I2C::Port::kMXP, LidarI2C::DEFAULT_ADDRESS))))
 
 {
 	left->SetDistancePerPulse(0.01031292364);
 	right->SetDistancePerPulse(-0.01031292364);
+
+	Biquad lowPass = Biquad::lowPass(DriveConstants::RATE_CUTOFF, DriveConstants::SENSOR_RATE);
+	for (int channel = 0; channel < sensorFilters.getChannels(); channel++)
+	{
+		sensorFilters.setMovingAverage(channel, DriveConstants::RATE_AVERAGE_SAMPLES);
+		sensorFilters.setBiquad(channel, 0, lowPass);
+	}
+
+	leftDistance = sampler.add(DriveConstants::ENCODER_SAMPLE_RATE, [this]() { return left->GetDistance(); });
+	rightDistance = sampler.add(DriveConstants::ENCODER_SAMPLE_RATE, [this]() { return right->GetDistance(); });
+	//eastDistance = sampler.add(50, [this]() { east->update(Timer::GetFPGATimestamp()); return east->getDistance(); });
+}
+
+//x is forward and y is to the left of where the pose was last reset
+const std::pair<float, float> RobotLocation::getPosition()
+{
+	Pose pose = getPose();
+	return std::make_pair(pose.x, pose.y);
+}
+
+void RobotLocation::updateOdometry(float leftDistance, float rightDistance)
+{
+	std::lock_guard<std::mutex> lock(poseMutex);
+	odometry.update(leftDistance, rightDistance, gyro->GetAngle());
+}
+
+void RobotLocation::resetPose()
+{
+	std::lock_guard<std::mutex> lock(poseMutex);
+	odometry.reset(leftDistance->get(), rightDistance->get(), gyro->GetAngle());
+}
+
+Pose RobotLocation::getPose() const
+{
+	std::lock_guard<std::mutex> lock(poseMutex);
+	return odometry.getPose();
+}
+
+void RobotLocation::filterSensors()
+{
+	sensorFilters.input(static_cast<int>(FilteredSensor::LeftRate), left->GetRate());
+	sensorFilters.input(static_cast<int>(FilteredSensor::RightRate), right->GetRate());
+	sensorFilters.input(static_cast<int>(FilteredSensor::TurnRate), gyro->GetRate());
+	sensorFilters.step();
+}
+
+float RobotLocation::getFiltered(FilteredSensor sensor) const
+{
+	return sensorFilters.output(static_cast<int>(sensor));
+}
+
+void RobotLocation::startSampling()
+{
+	sampler.start();
+}
+
+void RobotLocation::pollSampling()
+{
+	sampler.poll();
+}
+
+SampledSensor* RobotLocation::getLeftDistance()
+{
+	return leftDistance;
+}
+
+SampledSensor* RobotLocation::getRightDistance()
+{
+	return rightDistance;
 }
 
 /*Lidar* RobotLocation::getNorth()
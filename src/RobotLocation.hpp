@@ -6,9 +6,18 @@
 #include "DriveAuto.hpp"
 #include "TwoMotorGroup.hpp"
 #include <queue>
-#include "Lidar.hpp"
-#include "LidarPWM.hpp"
-#include "LidarI2C.hpp"
+#include "Odometry.hpp"
+#include <mutex>
+#include "FilterBank.hpp"
+#include "SensorSampler.hpp"
+
+//streams RobotLocation::filterSensors() smooths together, one FilterBank channel each
+enum class FilteredSensor
+{
+	LeftRate,
+	RightRate,
+	TurnRate
+};
 
 class RobotLocation
 {
@@ -16,6 +25,18 @@ public:
 	const std::pair<float, float> getPosition();
 	static RobotLocation* get();
 
+	void updateOdometry(float leftDistance, float rightDistance); //once per control cycle, with that cycle's sampled distances
+	void resetPose();      //the current position becomes the origin
+	Pose getPose() const;
+
+	void filterSensors(); //call once per loop from the main thread, filters every sensor in one pass
+	float getFiltered(FilteredSensor sensor) const;
+
+	void startSampling(); //reads the encoders on the sampler thread from here on
+	void pollSampling();  //one sampler tick on the caller's thread, for the simulator which doesn't start it
+	SampledSensor* getLeftDistance();  //PID sources that return the sampler's last reading
+	SampledSensor* getRightDistance();
+
 	const std::shared_ptr<Gyro> getGyro() const;
 	std::shared_ptr<Encoder> getLeftEncoder();
 	std::shared_ptr<Encoder> getRightEncoder();
@@ -27,6 +48,11 @@ private:
 	const std::shared_ptr<Gyro> gyro;
 	std::shared_ptr<Encoder> left, right;
 	static RobotLocation* instance;
+	Odometry odometry;
+	mutable std::mutex poseMutex;
+	FilterBank sensorFilters;
+	SensorSampler sampler;
+	SampledSensor *leftDistance, *rightDistance;
 
 	//Lidar *north, *east;
 };
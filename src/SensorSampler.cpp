@@ -0,0 +1,83 @@
+#include "SensorSampler.hpp"
+#include <algorithm>
+#include <cmath>
+
+SampledSensor::SampledSensor(std::function<double()> read, int divider)
+	: read(read)
+	, divider(divider)
+	, count(0)
+{
+}
+
+SensorSample SampledSensor::latest() const
+{
+	return published.load();
+}
+
+double SampledSensor::get() const
+{
+	return published.load().value;
+}
+
+double SampledSensor::PIDGet()
+{
+	return get();
+}
+
+SensorSampler::SensorSampler(double hz)
+	: rate(hz)
+	, ticks(0)
+	, thread(hz, std::bind(&SensorSampler::poll, this))
+{
+}
+
+SensorSampler::~SensorSampler()
+{
+	stop();
+}
+
+SampledSensor* SensorSampler::add(double hz, std::function<double()> read)
+{
+	if (thread.isRunning())
+		return nullptr;
+
+	int divider = std::max(1, static_cast<int>(std::lround(rate / hz)));
+	sensors.push_back(std::unique_ptr<SampledSensor>(new SampledSensor(read, divider)));
+	return sensors.back().get();
+}
+
+void SensorSampler::poll()
+{
+	for (const std::unique_ptr<SampledSensor> &sensor : sensors)
+	{
+		if (ticks % sensor->divider != 0)
+			continue;
+
+		SensorSample sample;
+		sample.time = Timer::GetFPGATimestamp();
+		sample.value = sensor->read();
+		sample.count = ++sensor->count;
+		sensor->published.store(sample);
+	}
+	ticks++;
+}
+
+bool SensorSampler::start(int priority)
+{
+	return thread.start(priority);
+}
+
+void SensorSampler::stop()
+{
+	thread.stop();
+}
+
+bool SensorSampler::isRunning() const
+{
+	return thread.isRunning();
+}
+
+ControlThread::Stats SensorSampler::getStats() const
+{
+	return thread.getStats();
+}
@@ -0,0 +1,68 @@
+#ifndef SENSOR_SAMPLER_HPP
+#define SENSOR_SAMPLER_HPP
+
+#include <WPILib.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "ControlThread.hpp"
+#include "Seqlock.hpp"
+
+struct SensorSample
+{
+	double value;
+	double time;    //FPGA seconds just before the read
+	uint32_t count; //reads published so far, 0 until the first
+};
+
+//the sampler's latest reading of one sensor, a PIDSource that never touches hardware
+class SampledSensor : public PIDSource
+{
+public:
+	SensorSample latest() const;
+	double get() const;
+	virtual double PIDGet();
+
+private:
+	friend class SensorSampler;
+	SampledSensor(std::function<double()> read, int divider);
+
+	const std::function<double()> read;
+	const int divider;
+	uint32_t count;
+	Seqlock<SensorSample> published;
+};
+
+/**
+ * Owns the reads of slow sensors so control loops don't do I/O.
+ * One background thread ticks at the sampler's rate and reads each sensor
+ * every divider ticks, so a sensor's rate is the sampler's divided down.
+ * Readings are published through a seqlock, so PID Notifiers and DriveAuto
+ * read the latest value in nanoseconds and never wait on the sampler.
+ */
+class SensorSampler
+{
+public:
+	explicit SensorSampler(double hz);
+	~SensorSampler();
+
+	SampledSensor* add(double hz, std::function<double()> read); //only while stopped
+	void poll(); //one tick, what the thread runs
+
+	bool start(int priority = 30);
+	void stop();
+	bool isRunning() const;
+	ControlThread::Stats getStats() const;
+
+private:
+	SensorSampler(const SensorSampler&);
+	SensorSampler& operator=(const SensorSampler&);
+
+	const double rate;
+	long long ticks;
+	std::vector<std::unique_ptr<SampledSensor>> sensors;
+	ControlThread thread;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Latest value of a trivially copyable T, written by one thread and read by any.
+ * The writer bumps a sequence number to odd, copies the value in, then bumps it
+ * to even; a reader copies the value out and retries if the sequence moved.
+ * Neither side ever waits on the other, a reader only repeats a copy that
+ * overlapped a store. The value is kept in atomic words so the overlapping
+ * copies aren't a data race.
+ */
+template <typename T>
+class Seqlock
+{
+public:
+	Seqlock()
+		: sequence(0)
+	{
+		store(T());
+	}
+
+	void store(const T &value) //one writer only
+	{
+		uint32_t next = sequence.load(std::memory_order_relaxed) + 1;
+		sequence.store(next, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		Words words = Words();
+		std::memcpy(words.data(), &value, sizeof(T));
+		for (std::size_t i = 0; i < WORDS; i++)
+			data[i].store(words[i], std::memory_order_relaxed);
+
+		sequence.store(next + 1, std::memory_order_release);
+	}
+
+	bool tryLoad(T &value) const //false if a store was under way
+	{
+		uint32_t before = sequence.load(std::memory_order_acquire);
+		if (before & 1)
+			return false;
+
+		Words words;
+		for (std::size_t i = 0; i < WORDS; i++)
+			words[i] = data[i].load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sequence.load(std::memory_order_relaxed) != before)
+			return false;
+
+		std::memcpy(&value, words.data(), sizeof(T));
+		return true;
+	}
+
+	T load() const
+	{
+		T value;
+		while (!tryLoad(value))
+		{
+		}
+		return value;
+	}
+
+private:
+	static const std::size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+	typedef std::array<uint32_t, WORDS> Words;
+
+	Seqlock(const Seqlock&);
+	Seqlock& operator=(const Seqlock&);
+
+	std::atomic<uint32_t> sequence;
+	std::array<std::atomic<uint32_t>, WORDS> data;
+};
+
+template <typename T>
+const std::size_t Seqlock<T>::WORDS;
+
+#endif
@@ -4,6 +4,7 @@
 #include "TwoMotorGroup.hpp"
 #include "DriveAuto.hpp"
 #include "RobotLocation.hpp"
+#include "LatencyTracer.hpp"
 
 
 Shifter::Shifter(int solenoidPortA, int solenoidPortB)
@@ -17,6 +18,7 @@ void Shifter::shiftHigh()
 	int pSpeedOne = DriveAuto::get()->getLeftMotors()->Get();
 	int pSpeedTwo = DriveAuto::get()->getRightMotors()->Get();
 	shift->Set(DoubleSolenoid::kReverse);
+	LatencyTracer::get()->issued(LatencyPath::Shifter, Timer::GetFPGATimestamp());
 	DriveAuto::get()->getLeftMotors()->Set(pSpeedOne);
 	DriveAuto::get()->getRightMotors()->Set(pSpeedTwo);
 }
@@ -26,14 +28,16 @@ void Shifter::shiftLow()
 	int pSpeedOne = DriveAuto::get()->getLeftMotors()->Get();
 	int pSpeedTwo = DriveAuto::get()->getRightMotors()->Get();
 	shift->Set(DoubleSolenoid::kForward);
+	LatencyTracer::get()->issued(LatencyPath::Shifter, Timer::GetFPGATimestamp());
 	DriveAuto::get()->getLeftMotors()->Set(pSpeedOne);
 	DriveAuto::get()->getRightMotors()->Set(pSpeedTwo);
 }
 
 void Shifter::shiftUpdate()
 {
-	auto leftSpeed = RobotLocation::get()->getLeftEncoder()->GetRate();
-	auto rightSpeed = RobotLocation::get()->getRightEncoder()->GetRate();
+	//filtered so encoder noise can't flap the shifter around the threshold
+	auto leftSpeed = RobotLocation::get()->getFiltered(FilteredSensor::LeftRate);
+	auto rightSpeed = RobotLocation::get()->getFiltered(FilteredSensor::RightRate);
 
 	float averageSpeed = (leftSpeed + rightSpeed)/2;
 	if(averageSpeed >= 100 && RobotLocation::get()->getLeftEncoder()->Get() != DoubleSolenoid::kForward && RobotLocation::get()->getRightEncoder()->Get() != DoubleSolenoid::kForward)
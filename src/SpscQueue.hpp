@@ -0,0 +1,57 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Lock-free queue for handing values from exactly one producer thread to
+ * exactly one consumer thread. Capacity must be a power of two.
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+	SpscQueue()
+		: head(0)
+		, tail(0)
+	{
+	}
+
+	bool push(const T& value) //producer only, returns false when full
+	{
+		std::size_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) == Capacity)
+			return false;
+
+		buffer[t & (Capacity - 1)] = value;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(T& value) //consumer only, returns false when empty
+	{
+		std::size_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire))
+			return false;
+
+		value = buffer[h & (Capacity - 1)];
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	std::size_t size() const
+	{
+		return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+	}
+
+private:
+	std::array<T, Capacity> buffer;
+	std::atomic<std::size_t> head;
+	std::atomic<std::size_t> tail;
+};
+
+#endif
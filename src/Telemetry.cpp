@@ -0,0 +1,129 @@
+#include "Telemetry.hpp"
+#include <cstdio>
+#include <cstring>
+
+const int Telemetry::MAX_CHANNELS;
+const int Telemetry::MAX_VALUES;
+const std::size_t Telemetry::CAPACITY;
+
+Telemetry* Telemetry::get()
+{
+	static Telemetry instance;
+	return &instance;
+}
+
+Telemetry::Telemetry()
+	: channelCount(0)
+	, dropped(0)
+	, epoch(std::chrono::steady_clock::now())
+	, running(false)
+{
+}
+
+Telemetry::~Telemetry()
+{
+	stop();
+}
+
+Telemetry::Channel Telemetry::channel(const char *name, const char *fields)
+{
+	std::lock_guard<std::mutex> lock(channelMutex);
+	int id = channelCount;
+	if (id == MAX_CHANNELS)
+		return MAX_CHANNELS - 1; //shares the last channel rather than failing
+
+	//fields points into a string literal, so keep pointers and lengths instead of copies
+	ChannelInfo &info = channels[id];
+	info.name = name;
+	info.fieldCount = 0;
+	const char *field = fields;
+	while (*field != '\0' && info.fieldCount < MAX_VALUES)
+	{
+		while (*field == ' ')
+			field++;
+		int length = std::strcspn(field, " ");
+		if (length == 0)
+			break;
+		info.fields[info.fieldCount] = field;
+		info.fieldLengths[info.fieldCount] = length;
+		info.fieldCount++;
+		field += length;
+	}
+
+	channelCount = id + 1;
+	return id;
+}
+
+bool Telemetry::record(Channel channel, float a, float b, float c, float d)
+{
+	Sample sample;
+	sample.channel = channel;
+	sample.seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - epoch).count();
+	sample.values[0] = a;
+	sample.values[1] = b;
+	sample.values[2] = c;
+	sample.values[3] = d;
+
+	if (samples.push(sample))
+		return true;
+	dropped.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+std::size_t Telemetry::drain(std::ostream &out)
+{
+	std::lock_guard<std::mutex> lock(drainMutex);
+	std::size_t count = 0;
+	Sample sample;
+	char line[256];
+	while (samples.pop(sample))
+	{
+		count++;
+		if (sample.channel >= channelCount)
+			continue;
+
+		const ChannelInfo &info = channels[sample.channel];
+		int length = std::snprintf(line, sizeof(line), "[%.3f] %s:", sample.seconds, info.name);
+		for (int i = 0; i < info.fieldCount && length < static_cast<int>(sizeof(line)); i++)
+			length += std::snprintf(line + length, sizeof(line) - length, " %.*s=%g",
+			                        info.fieldLengths[i], info.fields[i], sample.values[i]);
+		out << line << '\n';
+	}
+	if (count > 0)
+		out.flush();
+	return count;
+}
+
+void Telemetry::start(std::ostream &out, double period)
+{
+	if (running.exchange(true))
+		return;
+	thread = std::thread(&Telemetry::run, this, &out, period);
+}
+
+void Telemetry::stop()
+{
+	if (!running.exchange(false))
+		return;
+	thread.join();
+}
+
+bool Telemetry::isRunning() const
+{
+	return running;
+}
+
+void Telemetry::run(std::ostream *out, double period)
+{
+	while (running)
+	{
+		std::this_thread::sleep_for(std::chrono::duration<double>(period));
+		drain(*out);
+	}
+	drain(*out);
+}
+
+uint64_t Telemetry::getDropped() const
+{
+	return dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,87 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include "MpscQueue.hpp"
+
+//Verbose channels report every loop and are compiled out unless this is 1,
+//arguments included, so they cost nothing in a competition build.
+#ifndef TELEMETRY_VERBOSE
+#define TELEMETRY_VERBOSE 0
+#endif
+
+#if TELEMETRY_VERBOSE
+#define TELEMETRY_VERBOSE_RECORD(...) Telemetry::get()->record(__VA_ARGS__)
+#else
+#define TELEMETRY_VERBOSE_RECORD(...) ((void)0)
+#endif
+
+/**
+ * Numeric samples from the control loops, printed off the loop.
+ * record() copies a few numbers into a preallocated lock-free ring buffer
+ * and returns; a background thread formats and writes them out, so no
+ * loop ever waits on the console.
+ */
+class Telemetry
+{
+public:
+	typedef uint16_t Channel;
+	static const int MAX_CHANNELS = 64;
+	static const int MAX_VALUES = 4;
+	static const std::size_t CAPACITY = 1024;
+
+	static Telemetry* get();
+
+	//fields names the values, separated by spaces; call once per channel, not from a loop
+	Channel channel(const char *name, const char *fields);
+
+	//any thread, never blocks or allocates; false when the buffer was full and the sample dropped
+	bool record(Channel channel, float a = 0, float b = 0, float c = 0, float d = 0);
+
+	void start(std::ostream &out, double period = 0.05); //drain on a background thread every period seconds
+	void stop();
+	bool isRunning() const;
+	std::size_t drain(std::ostream &out); //write out everything buffered, consumer side only
+
+	uint64_t getDropped() const;
+
+	Telemetry();
+	~Telemetry();
+
+private:
+	struct Sample
+	{
+		Channel channel;
+		float seconds;
+		float values[MAX_VALUES];
+	};
+
+	struct ChannelInfo
+	{
+		const char *name;
+		std::array<const char*, MAX_VALUES> fields;
+		std::array<int, MAX_VALUES> fieldLengths;
+		int fieldCount;
+	};
+
+	void run(std::ostream *out, double period);
+
+	MpscQueue<Sample, CAPACITY> samples;
+	std::array<ChannelInfo, MAX_CHANNELS> channels;
+	std::atomic<int> channelCount;
+	std::mutex channelMutex;
+	std::mutex drainMutex;
+	std::atomic<uint64_t> dropped;
+	std::chrono::steady_clock::time_point epoch;
+
+	std::thread thread;
+	std::atomic<bool> running;
+};
+
+#endif
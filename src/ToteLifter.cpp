@@ -1,4 +1,5 @@
 #include "ToteLifter.hpp"
+#include "LatencyTracer.hpp"
 
 ToteLifter::ToteLifter()
 	: leftMotor(new Talon(0)),
@@ -6,7 +7,8 @@ ToteLifter::ToteLifter()
 	  limitSwitch(new DigitalInput(9)),
 	  isManualUp(false),
 	  isManualDown(false),
-	  override(false)
+	  override(false),
+	  limitChannel(Telemetry::get()->channel("ToteLifter limit switch", "pressed"))
 {
 }
 
@@ -29,14 +31,16 @@ void ToteLifter::manualDown()
 
 void ToteLifter::update()
 {
-	std::cout << "Limit Switch: " << limitSwitch->Get() << std::endl;
+	TELEMETRY_VERBOSE_RECORD(limitChannel, limitSwitch->Get());
 	if(isManualUp)
 	{
 		moveDown();
+		LatencyTracer::get()->issued(LatencyPath::Lifter, Timer::GetFPGATimestamp());
 	}
 	else if((isManualDown && limitSwitch->Get()) || (override && isManualDown))
 	{
 		moveUp();
+		LatencyTracer::get()->issued(LatencyPath::Lifter, Timer::GetFPGATimestamp());
 	}
 	else if(limitSwitch->Get() == false)
 	{
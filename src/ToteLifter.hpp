@@ -6,6 +6,7 @@
 #include <fstream>
 #include <ostream>
 #include <string>
+#include "Telemetry.hpp"
 
 class ToteLifter
 {
@@ -30,6 +31,7 @@ private:
 	std::shared_ptr<Talon> rightMotor;
 
 	DigitalInput *limitSwitch;
+	const Telemetry::Channel limitChannel;
 };
 
 #endif
@@ -0,0 +1,36 @@
+#ifndef TRAJECTORY_HPP
+#define TRAJECTORY_HPP
+
+#include <string>
+#include <vector>
+#include "MotionProfile.hpp"
+
+/**
+ * Left and right wheel profiles sampled every period seconds, plus the
+ * planned heading in degrees (counterclockwise from the starting heading).
+ */
+struct Trajectory
+{
+	std::string name;
+	float period;
+	std::vector<ProfileSample> left;
+	std::vector<ProfileSample> right;
+	std::vector<float> heading;
+};
+
+//Non-owning view of a trajectory, either in a Trajectory or a memory mapped cache file
+struct TrajectoryView
+{
+	const ProfileSample *left;
+	const ProfileSample *right;
+	const float *heading;
+	int count;
+	float period;
+
+	float getDuration() const
+	{
+		return (count - 1) * period;
+	}
+};
+
+#endif
@@ -0,0 +1,168 @@
+#include "TrajectoryCache.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+	const char MAGIC[4] = { 'T', 'R', 'J', 'C' };
+	const unsigned int VERSION = 2;
+}
+
+TrajectoryCache::TrajectoryCache()
+	: mapping(nullptr)
+	, mappingLength(0)
+	, sourceHash(0)
+{
+}
+
+TrajectoryCache::~TrajectoryCache()
+{
+	close();
+}
+
+bool TrajectoryCache::write(const std::string &file, const std::vector<Trajectory> &trajectories, unsigned int sourceHash)
+{
+	FileHeader header;
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.count = trajectories.size();
+	header.sourceHash = sourceHash;
+
+	std::vector<Entry> entries(trajectories.size());
+	unsigned int offset = sizeof(FileHeader) + sizeof(Entry) * entries.size();
+	for (std::size_t i = 0; i < trajectories.size(); i++)
+	{
+		const Trajectory &trajectory = trajectories[i];
+		if (trajectory.name.size() >= NAME_LENGTH
+		 || trajectory.left.size() != trajectory.right.size()
+		 || trajectory.left.size() != trajectory.heading.size()
+		 || trajectory.left.empty())
+			return false;
+
+		std::memset(entries[i].name, 0, NAME_LENGTH);
+		std::memcpy(entries[i].name, trajectory.name.c_str(), trajectory.name.size());
+		entries[i].sampleCount = trajectory.left.size();
+		entries[i].offset = offset;
+		entries[i].period = trajectory.period;
+		offset += trajectory.left.size() * (2 * sizeof(ProfileSample) + sizeof(float));
+	}
+
+	std::FILE *out = std::fopen(file.c_str(), "wb");
+	if (out == nullptr)
+		return false;
+
+	bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1;
+	if (!entries.empty())
+		ok = ok && std::fwrite(&entries[0], sizeof(Entry), entries.size(), out) == entries.size();
+	for (std::size_t i = 0; ok && i < trajectories.size(); i++)
+	{
+		const Trajectory &trajectory = trajectories[i];
+		std::size_t n = trajectory.left.size();
+		ok = std::fwrite(&trajectory.left[0], sizeof(ProfileSample), n, out) == n
+		  && std::fwrite(&trajectory.right[0], sizeof(ProfileSample), n, out) == n
+		  && std::fwrite(&trajectory.heading[0], sizeof(float), n, out) == n;
+	}
+
+	return std::fclose(out) == 0 && ok;
+}
+
+bool TrajectoryCache::open(const std::string &file)
+{
+	close();
+
+	int fd = ::open(file.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(FileHeader))
+	{
+		::close(fd);
+		return false;
+	}
+
+	mappingLength = info.st_size;
+	mapping = mmap(nullptr, mappingLength, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (mapping == MAP_FAILED)
+	{
+		mapping = nullptr;
+		mappingLength = 0;
+		return false;
+	}
+
+	const char *base = static_cast<const char*>(mapping);
+	const FileHeader *header = reinterpret_cast<const FileHeader*>(base);
+	if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+	 || header->version != VERSION
+	 || sizeof(FileHeader) + sizeof(Entry) * header->count > mappingLength)
+	{
+		close();
+		return false;
+	}
+
+	sourceHash = header->sourceHash;
+	const Entry *entries = reinterpret_cast<const Entry*>(base + sizeof(FileHeader));
+	for (unsigned int i = 0; i < header->count; i++)
+	{
+		const Entry &entry = entries[i];
+		std::size_t bytes = entry.sampleCount * (2 * sizeof(ProfileSample) + sizeof(float));
+		if (entry.sampleCount == 0 || entry.offset + bytes > mappingLength)
+		{
+			close();
+			return false;
+		}
+
+		TrajectoryView view;
+		view.left = reinterpret_cast<const ProfileSample*>(base + entry.offset);
+		view.right = view.left + entry.sampleCount;
+		view.heading = reinterpret_cast<const float*>(view.right + entry.sampleCount);
+		view.count = entry.sampleCount;
+		view.period = entry.period;
+
+		names.push_back(std::string(entry.name, strnlen(entry.name, NAME_LENGTH)));
+		views.push_back(view);
+	}
+
+	return true;
+}
+
+void TrajectoryCache::close()
+{
+	if (mapping != nullptr)
+		munmap(mapping, mappingLength);
+	mapping = nullptr;
+	mappingLength = 0;
+	sourceHash = 0;
+	names.clear();
+	views.clear();
+}
+
+bool TrajectoryCache::isOpen() const
+{
+	return mapping != nullptr;
+}
+
+const TrajectoryView* TrajectoryCache::find(const std::string &name) const
+{
+	for (std::size_t i = 0; i < names.size(); i++)
+	{
+		if (names[i] == name)
+			return &views[i];
+	}
+	return nullptr;
+}
+
+std::size_t TrajectoryCache::size() const
+{
+	return views.size();
+}
+
+unsigned int TrajectoryCache::getSourceHash() const
+{
+	return sourceHash;
+}
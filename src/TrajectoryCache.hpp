@@ -0,0 +1,63 @@
+#ifndef TRAJECTORY_CACHE_HPP
+#define TRAJECTORY_CACHE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Trajectory.hpp"
+
+/**
+ * Compact binary file of precomputed trajectories.
+ * open() memory maps the file and find() returns views straight into the
+ * mapping, so picking an autonomous routine costs a name lookup.
+ *
+ * Layout: FileHeader, one Entry per trajectory, then for each trajectory
+ * its left samples, right samples and headings.
+ */
+class TrajectoryCache
+{
+public:
+	TrajectoryCache();
+	~TrajectoryCache();
+
+	//sourceHash identifies what the trajectories were planned from, so callers can tell a stale file
+	static bool write(const std::string &file, const std::vector<Trajectory> &trajectories, unsigned int sourceHash = 0);
+
+	bool open(const std::string &file);
+	void close();
+	bool isOpen() const;
+
+	const TrajectoryView* find(const std::string &name) const;
+	std::size_t size() const;
+	unsigned int getSourceHash() const; //as passed to write()
+
+private:
+	static const int NAME_LENGTH = 24;
+
+	struct FileHeader
+	{
+		char magic[4];
+		unsigned int version;
+		unsigned int count;
+		unsigned int sourceHash;
+	};
+
+	struct Entry
+	{
+		char name[NAME_LENGTH];
+		unsigned int sampleCount;
+		unsigned int offset; //bytes from the start of the file to the left samples
+		float period;
+	};
+
+	TrajectoryCache(const TrajectoryCache&);
+	TrajectoryCache& operator=(const TrajectoryCache&);
+
+	void *mapping;
+	std::size_t mappingLength;
+	unsigned int sourceHash;
+	std::vector<std::string> names;
+	std::vector<TrajectoryView> views;
+};
+
+#endif
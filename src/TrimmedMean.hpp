@@ -0,0 +1,179 @@
+#ifndef TRIMMED_MEAN_HPP
+#define TRIMMED_MEAN_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+#include "FreeListAllocator.hpp"
+
+/**
+ * Average of the last length values with the trim lowest and trim highest dropped.
+ * The window is split across three ordered sets, the trimmed low and high tails
+ * and the middle, and only the middle's sum is kept, so a sample is O(log n)
+ * instead of re-sorting or re-summing the window. The sets' nodes come from a
+ * free list sized for the window up front, so a full window never allocates.
+ * Until the window fills, the trim is cut back so at least one value is kept.
+ */
+template <typename T>
+class TrimmedMean
+{
+public:
+	TrimmedMean(std::size_t length, std::size_t trim)
+		: window(length > 0 ? length : 1)
+		, trim(trim)
+		, next(0)
+		, count(0)
+		, arena(new FreeListArena(window.size() + 2))
+		, low(std::less<T>(), Allocator(arena.get()))
+		, mid(std::less<T>(), Allocator(arena.get()))
+		, high(std::less<T>(), Allocator(arena.get()))
+		, midSum()
+	{
+		//the first node sizes the arena's blocks, better here than on the first sample
+		mid.erase(mid.insert(T()));
+	}
+
+	void giveRawValue(T value)
+	{
+		if (count == window.size())
+			remove(window[next]);
+		else
+			count++;
+
+		window[next] = value;
+		insert(value);
+		balance();
+
+		if (++next == window.size())
+		{
+			next = 0;
+			resum();
+		}
+	}
+
+	T computeAverage() const
+	{
+		return mid.empty() ? T() : midSum / static_cast<T>(mid.size());
+	}
+
+	void reset()
+	{
+		low.clear();
+		mid.clear();
+		high.clear();
+		midSum = T();
+		next = 0;
+		count = 0;
+	}
+
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	std::size_t length() const
+	{
+		return window.size();
+	}
+
+private:
+	typedef FreeListAllocator<T> Allocator;
+	typedef std::multiset<T, std::less<T>, Allocator> Set;
+
+	//lands the value in whichever part it belongs to, balance() evens out the tails
+	void insert(T value)
+	{
+		if (!low.empty() && value < *low.rbegin())
+			low.insert(value);
+		else if (!high.empty() && *high.begin() < value)
+			high.insert(value);
+		else
+			addMid(value);
+	}
+
+	//equal values are interchangeable, so any copy of the value will do
+	void remove(T value)
+	{
+		if (!low.empty() && !(*low.rbegin() < value))
+			low.erase(low.find(value));
+		else if (!high.empty() && !(value < *high.begin()))
+			high.erase(high.find(value));
+		else
+			removeMid(mid.find(value));
+	}
+
+	void balance()
+	{
+		std::size_t target = trim < (count - 1) / 2 ? trim : (count - 1) / 2;
+
+		while (low.size() > target)
+		{
+			T value = *low.rbegin();
+			low.erase(std::prev(low.end()));
+			addMid(value);
+		}
+		while (high.size() > target)
+		{
+			T value = *high.begin();
+			high.erase(high.begin());
+			addMid(value);
+		}
+		while (low.size() < target)
+		{
+			T value = *mid.begin();
+			removeMid(mid.begin());
+			low.insert(value);
+		}
+		while (high.size() < target)
+		{
+			T value = *mid.rbegin();
+			removeMid(std::prev(mid.end()));
+			high.insert(value);
+		}
+	}
+
+	void addMid(T value)
+	{
+		mid.insert(value);
+		midSum += value;
+	}
+
+	void removeMid(typename Set::iterator it)
+	{
+		midSum -= *it;
+		mid.erase(it);
+	}
+
+	//once per lap of the window, so rounding in the running sum can't build up
+	void resum()
+	{
+		midSum = T();
+		for (const T &value : mid)
+			midSum += value;
+	}
+
+	std::vector<T> window;
+	std::size_t trim;
+	std::size_t next;
+	std::size_t count;
+	std::unique_ptr<FreeListArena> arena;
+	Set low;
+	Set mid;
+	Set high;
+	T midSum;
+};
+
+//median of the last length values, the mean of the middle two when length is even
+template <typename T>
+class MovingMedian : public TrimmedMean<T>
+{
+public:
+	explicit MovingMedian(std::size_t length)
+		: TrimmedMean<T>(length, length > 0 ? (length - 1) / 2 : 0)
+	{
+	}
+};
+
+#endif
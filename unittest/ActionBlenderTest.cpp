@@ -0,0 +1,228 @@
+#include <catch.hpp>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "ActionBlender.hpp"
+#include "ActionQueue.hpp"
+#include "DriveAction.hpp"
+#include "DriveConstants.hpp"
+#include "HeadingController.hpp"
+#include "MotionProfile.hpp"
+#include "ProfileFollower.hpp"
+#include "SimulatedDrive.hpp"
+
+using namespace DriveConstants;
+
+namespace
+{
+	const float SIM_DT = 0.001f;
+	const float LOOP_PERIOD = 0.01f;
+	const float PI = 3.14159265f;
+
+	typedef ActionQueue<DriveAction, 32> Queue;
+
+	ActionBlender blender()
+	{
+		return ActionBlender(TRACK_WIDTH, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD, BLEND_MAX_TURN, BLEND_RADIUS);
+	}
+
+	struct RoutineResult
+	{
+		float seconds;
+		Pose end;
+	};
+
+	//DriveAuto's Move and Turn handling against the simulated drive
+	RoutineResult runRoutine(Queue queue, bool blending)
+	{
+		SimulatedDrive robot;
+		static ActionBlender blend = blender();
+		static MotionProfile profile;
+		ProfileFollower left(MOVE_KV, MOVE_KA, MOVE_KP, MOVE_KD, MOVE_TOLERANCE, MOVE_TIMEOUT);
+		ProfileFollower right(MOVE_KV, MOVE_KA, MOVE_KP, MOVE_KD, MOVE_TOLERANCE, MOVE_TIMEOUT);
+		HeadingController turn(TURN_MAX_RATE, TURN_MAX_ACCELERATION, TURN_KV, TURN_KP, TURN_KD, TURN_MIN_OUTPUT,
+		                       TURN_TOLERANCE, TURN_SETTLE_TIME, TURN_TIMEOUT);
+
+		bool starting = true;
+		int covered = 1;
+		float actionStart = 0, leftStart = 0, rightStart = 0;
+		float leftOutput = 0, rightOutput = 0;
+		float t = 0, nextLoop = 0;
+		while (!queue.empty() && t < 30)
+		{
+			if (t >= nextLoop)
+			{
+				const DriveAction &action = queue.front();
+				float elapsed = t - actionStart;
+				if (starting)
+				{
+					starting = false;
+					actionStart = t;
+					elapsed = 0;
+					leftStart = robot.leftDistance;
+					rightStart = robot.rightDistance;
+					if (action.type == DriveAction::Move)
+					{
+						covered = blending ? blend.plan(queue) : 0;
+						if (covered > 1)
+						{
+							left.start(blend.getLeft(), blend.size(), blend.getPeriod());
+							right.start(blend.getRight(), blend.size(), blend.getPeriod());
+						}
+						else
+						{
+							covered = 1;
+							profile.generate(action.move.inches, std::abs(action.move.motorVelocity) * MAX_VELOCITY,
+							                 MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD);
+							left.start(&profile);
+							right.start(&profile);
+						}
+					}
+					else
+					{
+						covered = 1;
+						turn.start(-robot.pose.heading, action.turn.degrees, 0);
+					}
+				}
+
+				bool done;
+				if (action.type == DriveAction::Move)
+				{
+					float leftTravel = robot.leftDistance - leftStart;
+					float rightTravel = robot.rightDistance - rightStart;
+					done = left.isFinished(elapsed, leftTravel) && right.isFinished(elapsed, rightTravel);
+					leftOutput = done ? 0 : left.calculate(elapsed, leftTravel);
+					rightOutput = done ? 0 : right.calculate(elapsed, rightTravel);
+				}
+				else
+				{
+					float output = turn.calculate(-robot.pose.heading, elapsed);
+					done = turn.isFinished();
+					leftOutput = done ? 0 : output;
+					rightOutput = done ? 0 : -output;
+				}
+
+				if (done)
+				{
+					for (int i = 0; i < covered; i++)
+						queue.pop();
+					starting = true;
+				}
+				nextLoop += LOOP_PERIOD;
+			}
+			robot.step(leftOutput, rightOutput, SIM_DT);
+			t += SIM_DT;
+		}
+
+		RoutineResult result = { t, robot.pose };
+		return result;
+	}
+
+	Queue routine(const std::vector<DriveAction> &actions)
+	{
+		Queue queue;
+		for (const DriveAction &action : actions)
+			queue.push(action);
+		return queue;
+	}
+
+	//where the legs end up when driven exactly, turns positive to the right
+	Pose idealEnd(const std::vector<DriveAction> &actions)
+	{
+		Pose pose = { 0, 0, 0 };
+		for (const DriveAction &action : actions)
+		{
+			if (action.type == DriveAction::Turn)
+				pose.heading -= action.turn.degrees;
+			else
+			{
+				pose.x += action.move.inches * std::cos(pose.heading * PI / 180);
+				pose.y += action.move.inches * std::sin(pose.heading * PI / 180);
+			}
+		}
+		return pose;
+	}
+}
+
+TEST_CASE("ActionBlender joins moves and shallow turns but not sharp turns", "[ActionBlender]")
+{
+	Queue queue = routine({ DriveAction::makeMove(60, 1, 0), DriveAction::makeTurn(30), DriveAction::makeMove(40, 1, 1),
+	                        DriveAction::makeTurn(90), DriveAction::makeMove(40, 1, 2) });
+	ActionBlender blend = blender();
+	REQUIRE(blend.plan(queue) == 3);
+
+	//a lone move, and a move followed by nothing but a turn, are left alone
+	REQUIRE(blend.plan(routine({ DriveAction::makeMove(60, 1, 0) })) == 0);
+	REQUIRE(blend.plan(routine({ DriveAction::makeMove(60, 1, 0), DriveAction::makeTurn(30) })) == 0);
+	REQUIRE(blend.plan(routine({ DriveAction::makeMove(60, 1, 0), DriveAction::makeWait(1), DriveAction::makeMove(60, 1, 1) })) == 0);
+
+	//reversing direction needs to stop
+	REQUIRE(blend.plan(routine({ DriveAction::makeMove(60, 1, 0), DriveAction::makeMove(-60, 1, 1) })) == 0);
+	REQUIRE(blend.plan(routine({ DriveAction::makeMove(-60, 1, 0), DriveAction::makeMove(-30, 1, 1) })) == 2);
+}
+
+TEST_CASE("ActionBlender profiles keep the wheels moving through a corner", "[ActionBlender]")
+{
+	Queue queue = routine({ DriveAction::makeMove(60, 1, 0), DriveAction::makeTurn(45), DriveAction::makeMove(60, 1, 1) });
+	ActionBlender blend = blender();
+	REQUIRE(blend.plan(queue) == 3);
+
+	//turning right, the left wheel covers the extra arc length
+	const ProfileSample &leftEnd = blend.getLeft()[blend.size() - 1];
+	const ProfileSample &rightEnd = blend.getRight()[blend.size() - 1];
+	float extra = leftEnd.position - rightEnd.position;
+	REQUIRE(extra == Approx(TRACK_WIDTH * PI / 4));
+	REQUIRE(leftEnd.velocity == 0);
+	REQUIRE(rightEnd.velocity == 0);
+
+	//neither wheel stops, or is asked to go faster than the drivetrain can, between the ends
+	float slowest = MAX_VELOCITY, fastest = 0;
+	for (int i = blend.size() / 4; i < blend.size() * 3 / 4; i++)
+	{
+		slowest = std::min(slowest, std::min(blend.getLeft()[i].velocity, blend.getRight()[i].velocity));
+		fastest = std::max(fastest, std::max(blend.getLeft()[i].velocity, blend.getRight()[i].velocity));
+	}
+	REQUIRE(slowest > 20);
+	REQUIRE(fastest <= MAX_VELOCITY + 0.01f);
+}
+
+TEST_CASE("Blended routines end where the stop-and-go routine does, sooner", "[ActionBlender]")
+{
+	std::vector<DriveAction> actions = { DriveAction::makeMove(60, 1, 0), DriveAction::makeTurn(45), DriveAction::makeMove(48, 1, 1),
+	                                     DriveAction::makeTurn(-30), DriveAction::makeMove(36, 1, 2) };
+	Pose ideal = idealEnd(actions);
+
+	RoutineResult stopAndGo = runRoutine(routine(actions), false);
+	RoutineResult blended = runRoutine(routine(actions), true);
+	INFO("move/turn routine: stop-and-go " << stopAndGo.seconds << " s, blended " << blended.seconds << " s");
+
+	REQUIRE(std::hypot(stopAndGo.end.x - ideal.x, stopAndGo.end.y - ideal.y) < 3);
+	REQUIRE(std::hypot(blended.end.x - ideal.x, blended.end.y - ideal.y) < 3);
+	REQUIRE(std::abs(blended.end.heading - ideal.heading) < 3);
+	REQUIRE(blended.seconds < stopAndGo.seconds * 0.75f);
+}
+
+TEST_CASE("Autonomous routine time with and without blending", "[.][benchmark]")
+{
+	struct Case
+	{
+		const char *name;
+		std::vector<DriveAction> actions;
+	};
+	std::vector<Case> cases = {
+		{ "three moves", { DriveAction::makeMove(40, 1, 0), DriveAction::makeMove(40, 1, 1), DriveAction::makeMove(40, 1, 2) } },
+		{ "move, turn 30, move", { DriveAction::makeMove(72, 1, 0), DriveAction::makeTurn(30), DriveAction::makeMove(72, 1, 1) } },
+		{ "slalom", { DriveAction::makeMove(48, 1, 0), DriveAction::makeTurn(45), DriveAction::makeMove(36, 1, 1),
+		              DriveAction::makeTurn(-45), DriveAction::makeMove(36, 1, 2), DriveAction::makeTurn(-45),
+		              DriveAction::makeMove(36, 1, 3), DriveAction::makeTurn(45), DriveAction::makeMove(48, 1, 4) } },
+		{ "move, turn 90, move", { DriveAction::makeMove(72, 1, 0), DriveAction::makeTurn(90), DriveAction::makeMove(72, 1, 1) } },
+	};
+
+	for (const Case &c : cases)
+	{
+		RoutineResult off = runRoutine(routine(c.actions), false);
+		RoutineResult on = runRoutine(routine(c.actions), true);
+		std::cout << c.name << ":\tblending off " << off.seconds << " s, on " << on.seconds << " s" << std::endl;
+		REQUIRE(on.seconds <= off.seconds + 0.01f);
+	}
+}
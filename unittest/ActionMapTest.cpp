@@ -0,0 +1,222 @@
+#include <catch.hpp>
+#include <functional>
+#include <map>
+#include "ActionMap.hpp"
+#include "ButtonEdges.hpp"
+#include "AllocationCounter.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+	struct Counter
+	{
+		int count;
+		Counter() : count(0) {}
+		void bump() { count++; }
+	};
+
+	Action<void()> bump(Counter &counter)
+	{
+		return Action<void()>(std::bind(&Counter::bump, &counter), 0);
+	}
+}
+
+TEST_CASE("ActionMap binds down and up of the same button separately", "[actionmap]")
+{
+	ActionMap map;
+	Counter onDown, onUp;
+	map.associate(JoyButton(true, false, false, Button7), bump(onDown));
+	map.associate(JoyButton(false, false, true, Button7), bump(onUp));
+
+	ButtonEdges edges;
+	edges.update(ButtonEdges::bit(Button7));
+	map.dispatch(edges);
+	edges.update(ButtonEdges::bit(Button7));
+	map.dispatch(edges);
+	edges.update(0);
+	map.dispatch(edges);
+
+	REQUIRE(onDown.count == 1);
+	REQUIRE(onUp.count == 1);
+}
+
+TEST_CASE("ActionMap shares one action between the edges it is bound to", "[actionmap]")
+{
+	ActionMap map;
+	Counter counter;
+	map.associate(JoyButton(true, false, true, Button9), bump(counter));
+	REQUIRE(map.fire(Button9, ButtonEdge::Down) == 1);
+	REQUIRE(map.fire(Button9, ButtonEdge::Up) == 1);
+	REQUIRE(map.fire(Button9, ButtonEdge::Pressed) == 0);
+	REQUIRE(counter.count == 2);
+}
+
+TEST_CASE("ActionMap whileHeld bindings run on every poll the button is held", "[actionmap]")
+{
+	ActionMap map;
+	Counter held, onDown;
+	map.associate(JoyButton::whileHeld(TopRight), bump(held));
+	map.associate(JoyButton(true, false, false, TopRight), bump(onDown));
+
+	ButtonEdges edges;
+	for (int poll = 0; poll < 5; poll++)
+	{
+		edges.update(ButtonEdges::bit(TopRight));
+		map.dispatch(edges);
+	}
+	edges.update(0);
+	map.dispatch(edges);
+
+	REQUIRE(held.count == 5);
+	REQUIRE(onDown.count == 1);
+}
+
+TEST_CASE("ActionMap runs every callback in a slot", "[actionmap]")
+{
+	ActionMap map;
+	Counter first, second;
+	map.associate(Trigger, ButtonEdge::Pressed, bump(first));
+	map.associate(Trigger, ButtonEdge::Pressed, bump(second));
+	REQUIRE(map.size(Trigger, ButtonEdge::Pressed) == 2);
+
+	REQUIRE(map.fire(Trigger, ButtonEdge::Pressed) == 2);
+	REQUIRE(first.count == 1);
+	REQUIRE(second.count == 1);
+	REQUIRE(map.fire(Trigger, ButtonEdge::Down) == 0);
+}
+
+TEST_CASE("ActionMap dispatches all of a poll's edges in one pass", "[actionmap]")
+{
+	ActionMap map;
+	Counter counters[ActionMap::BUTTONS];
+	for (int button = 1; button <= ActionMap::BUTTONS; button++)
+		map.associate(button, ButtonEdge::Down, bump(counters[button - 1]));
+
+	ButtonEdges edges;
+	edges.update(ButtonEdges::bit(2) | ButtonEdges::bit(5) | ButtonEdges::bit(12) | ButtonEdges::bit(20));
+
+	std::size_t before = allocationCount();
+	int ran = map.dispatch(edges);
+	std::size_t after = allocationCount();
+
+	REQUIRE(ran == 3);
+	REQUIRE(after == before);
+	REQUIRE(counters[1].count == 1);
+	REQUIRE(counters[4].count == 1);
+	REQUIRE(counters[11].count == 1);
+	REQUIRE(counters[0].count == 0);
+}
+
+TEST_CASE("ActionMap ignores buttons outside the table", "[actionmap]")
+{
+	ActionMap map;
+	Counter counter;
+	map.associate(0, ButtonEdge::Down, bump(counter));
+	map.associate(ActionMap::BUTTONS + 1, ButtonEdge::Down, bump(counter));
+	REQUIRE(map.fire(0, ButtonEdge::Down) == 0);
+	REQUIRE(map.fire(ActionMap::BUTTONS + 1, ButtonEdge::Down) == 0);
+}
+
+TEST_CASE("ActionMap chords fire once when every button is held", "[actionmap]")
+{
+	ActionMap map;
+	Counter chord, trigger;
+	map.associate(JoyButton::together(TopLeft, Trigger), bump(chord));
+	map.associate(Trigger, ButtonEdge::Down, bump(trigger));
+
+	REQUIRE(map.update(ButtonEdges::bit(TopLeft), 0) == 0);
+	REQUIRE(map.update(ButtonEdges::bit(TopLeft) | ButtonEdges::bit(Trigger), 0.02) == 1);
+	REQUIRE(map.update(ButtonEdges::bit(TopLeft) | ButtonEdges::bit(Trigger) | ButtonEdges::bit(Button7), 0.04) == 0);
+	map.update(ButtonEdges::bit(Trigger), 0.06);
+	map.update(ButtonEdges::bit(TopLeft) | ButtonEdges::bit(Trigger), 0.08);
+
+	REQUIRE(chord.count == 2);
+	REQUIRE(trigger.count == 0); //edge bindings only run from dispatch
+}
+
+TEST_CASE("ActionMap holds fire after the hold time and rearm on release", "[actionmap]")
+{
+	ActionMap map;
+	Counter counter;
+	map.associate(JoyButton::held(Button9, 0.3f), bump(counter));
+	REQUIRE(map.size(Button9, ButtonEdge::Down) == 0);
+
+	uint32_t nine = ButtonEdges::bit(Button9);
+	map.update(nine, 1.0);
+	map.update(nine, 1.29);
+	REQUIRE(counter.count == 0);
+	map.update(nine, 1.3);
+	map.update(nine, 1.5);
+	REQUIRE(counter.count == 1);
+
+	map.update(0, 1.52);
+	map.update(nine, 1.54);
+	map.update(0, 1.80);
+	map.update(nine, 1.82);
+	REQUIRE(counter.count == 1); //neither press lasted 0.3 s
+	map.update(nine, 2.12);
+	REQUIRE(counter.count == 2);
+}
+
+TEST_CASE("ActionMap combo table is fixed size", "[actionmap]")
+{
+	ActionMap map;
+	Counter counter;
+	for (int i = 0; i < ActionMap::MAX_COMBOS; i++)
+		REQUIRE(map.associateCombo(ButtonEdges::bit(i + 1), 0, bump(counter)));
+	REQUIRE_FALSE(map.associateCombo(ButtonEdges::bit(Button12), 0, bump(counter)));
+
+	std::size_t before = allocationCount();
+	int ran = map.update(~0u, 0);
+	std::size_t after = allocationCount();
+	REQUIRE(ran == ActionMap::MAX_COMBOS);
+	REQUIRE(after == before);
+}
+
+TEST_CASE("ActionMap dispatch cost", "[.][benchmark]")
+{
+	Counter counter;
+	const int POLLS = 200000;
+
+	//the old std::map keyed on JoyButton name: two lookups and a copy of the callback per event
+	std::map<JoyButton, std::function<void()> > tree;
+	for (int button = 1; button <= ActionMap::BUTTONS; button++)
+		tree.insert(std::make_pair(JoyButton(true, false, false, static_cast<ButtonNames>(button)), std::bind(&Counter::bump, &counter)));
+	JoyButton held[ActionMap::BUTTONS];
+	for (int button = 1; button <= ActionMap::BUTTONS; button++)
+	{
+		held[button - 1].name = static_cast<ButtonNames>(button);
+		held[button - 1].down = (button % 3) == 0;
+	}
+	double treeNs = nanosecondsPerIteration(POLLS, [&](int)
+	{
+		for (const JoyButton &button : held)
+		{
+			if (button.down || button.pressed || button.up)
+			{
+				if (tree.find(button) != tree.end())
+				{
+					auto action = tree.find(button)->second;
+					action();
+				}
+			}
+		}
+	});
+
+	ActionMap map;
+	for (int button = 1; button <= ActionMap::BUTTONS; button++)
+		map.associate(button, ButtonEdge::Down, bump(counter));
+	uint32_t word = 0;
+	for (int button = 3; button <= ActionMap::BUTTONS; button += 3)
+		word |= ButtonEdges::bit(button);
+	double tableNs = nanosecondsPerIteration(POLLS, [&](int)
+	{
+		ButtonEdges edges;
+		edges.update(word);
+		map.dispatch(edges);
+	});
+
+	reportBenchmark("std::map lookup and copy, 4 events", treeNs);
+	reportBenchmark("dense table from edge masks, 4 events", tableNs);
+	REQUIRE(counter.count == 8 * POLLS);
+}
@@ -0,0 +1,110 @@
+#include <catch.hpp>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "ActionQueue.hpp"
+#include "DriveAction.hpp"
+#include "AllocationCounter.hpp"
+#include "Benchmark.hpp"
+
+TEST_CASE("ActionQueue is first in first out", "[actionqueue]") {
+	ActionQueue<DriveAction, 4> queue;
+	queue.push(DriveAction::makeMove(72, 0.5f, 3));
+	queue.push(DriveAction::makeTurn(90));
+	queue.push(DriveAction::makeWait(1.5f));
+
+	REQUIRE(queue.size() == 3);
+	REQUIRE(queue.front().type == DriveAction::Move);
+	REQUIRE(queue.front().move.inches == 72);
+	REQUIRE(queue.front().move.profileSlot == 3);
+	REQUIRE(queue.peek(1).turn.degrees == 90);
+	queue.pop();
+	REQUIRE(queue.front().type == DriveAction::Turn);
+	queue.pop();
+	REQUIRE(queue.front().wait.seconds == 1.5f);
+	queue.pop();
+	REQUIRE(queue.empty());
+}
+
+TEST_CASE("ActionQueue wraps around and rejects pushes when full", "[actionqueue]") {
+	ActionQueue<DriveAction, 3> queue;
+	for (int i = 0; i < 10; i++)
+	{
+		REQUIRE(queue.push(DriveAction::makeWait(i)));
+		REQUIRE(queue.front().wait.seconds == i);
+		queue.pop();
+	}
+
+	REQUIRE(queue.push(DriveAction::makeWait(1)));
+	REQUIRE(queue.push(DriveAction::makeWait(2)));
+	REQUIRE(queue.push(DriveAction::makeWait(3)));
+	REQUIRE_FALSE(queue.push(DriveAction::makeWait(4)));
+	REQUIRE(queue.size() == 3);
+	REQUIRE(queue.peek(2).wait.seconds == 3);
+}
+
+TEST_CASE("ActionQueue tracks depth and high-water mark", "[actionqueue]") {
+	ActionQueue<DriveAction, 8> queue;
+	for (int i = 0; i < 5; i++)
+		queue.push(DriveAction::makeTurn(i));
+	queue.pop();
+	queue.pop();
+
+	REQUIRE(queue.size() == 3);
+	REQUIRE(queue.highWaterMark() == 5);
+
+	queue.clear();
+	REQUIRE(queue.empty());
+	REQUIRE(queue.highWaterMark() == 5);
+	queue.resetHighWaterMark();
+	REQUIRE(queue.highWaterMark() == 0);
+}
+
+TEST_CASE("ActionQueue never allocates", "[actionqueue]") {
+	ActionQueue<DriveAction, 32> queue;
+	std::size_t before = allocationCount();
+	for (int i = 0; i < 10000; i++)
+	{
+		queue.push(DriveAction::makeMove(i, 0.5f, 0));
+		queue.push(DriveAction::makeTurn(90));
+		queue.pop();
+		queue.pop();
+	}
+	std::size_t after = allocationCount();
+
+	REQUIRE(after == before);
+}
+
+TEST_CASE("ActionQueue enqueue and drain benchmark", "[.][benchmark]") {
+	const int ACTIONS = 10000;
+
+	ActionQueue<DriveAction, 32> ring;
+	double ringNs = nanosecondsPerIteration(ACTIONS, [&] (int i) {
+		ring.push(DriveAction::makeMove(i, 0.5f, 0));
+		ring.push(DriveAction::makeWait(1));
+		volatile float inches = ring.front().move.inches;
+		ring.pop();
+		ring.pop();
+	});
+
+	std::queue<std::pair<DriveAction::Type, std::vector<float>>> vectorQueue;
+	std::size_t before = allocationCount();
+	double vectorNs = nanosecondsPerIteration(ACTIONS, [&] (int i) {
+		std::vector<float> moveParams;
+		moveParams.push_back(i);
+		moveParams.push_back(0.5f);
+		moveParams.push_back(0);
+		vectorQueue.push(std::make_pair(DriveAction::Move, moveParams));
+		std::vector<float> waitParams;
+		waitParams.push_back(1);
+		vectorQueue.push(std::make_pair(DriveAction::Wait, waitParams));
+		volatile float inches = vectorQueue.front().second[0];
+		vectorQueue.pop();
+		vectorQueue.pop();
+	});
+	std::size_t vectorAllocations = allocationCount() - before;
+
+	reportBenchmark("ring buffer, two actions", ringNs);
+	reportBenchmark("std::queue of vectors, two actions", vectorNs);
+	std::cout << "std::queue of vectors allocations: " << vectorAllocations << std::endl;
+}
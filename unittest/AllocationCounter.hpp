@@ -0,0 +1,9 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+//number of calls to global operator new since the test binary started
+std::size_t allocationCount();
+
+#endif
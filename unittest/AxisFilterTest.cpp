@@ -0,0 +1,193 @@
+#include <catch.hpp>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include "AxisFilter.hpp"
+#include "DriveConstants.hpp"
+#include "AllocationCounter.hpp"
+
+namespace
+{
+	const double PACKET_PERIOD = 0.02;
+
+	//the old EventRelay chain: 0.1 deadband then a 25 sample moving average
+	struct LegacyAverage
+	{
+		std::array<float, 25> window;
+		int next;
+		int filled;
+
+		LegacyAverage()
+			: window()
+			, next(0)
+			, filled(0)
+		{
+		}
+
+		float operator()(float x)
+		{
+			x = std::abs(x) > 0.1f ? x : 0;
+			window[next] = x;
+			next = (next + 1) % window.size();
+			if (filled < static_cast<int>(window.size()))
+				filled++;
+			float sum = 0;
+			for (int i = 0; i < filled; i++)
+				sum += window[i];
+			return sum / filled;
+		}
+
+		float settle(float x) const
+		{
+			return std::abs(x) > 0.1f ? x : 0;
+		}
+	};
+
+	struct StepResponse
+	{
+		double delay;       //seconds from the step until the output stays within 5% of where it settles
+		double overshoot;
+		double jitter;      //output standard deviation with the stick held at 0.6 and +-0.03 noise
+	};
+
+	template <typename Filter>
+	StepResponse measure(Filter filter)
+	{
+		StepResponse response = { 0, 0, 0 };
+		const float STEP = 0.9f;
+		float target = filter.settle(STEP);
+
+		for (int i = 0; i < 10; i++)
+			filter(0);
+		int settledAt = -1;
+		for (int i = 0; i < 100; i++)
+		{
+			float output = filter(STEP);
+			if (std::abs(output - target) > 0.05f * target)
+				settledAt = -1;
+			else if (settledAt < 0)
+				settledAt = i;
+			if (output - target > response.overshoot)
+				response.overshoot = output - target;
+		}
+		response.delay = settledAt * PACKET_PERIOD;
+
+		double sum = 0;
+		double squares = 0;
+		const int SAMPLES = 200;
+		for (int i = 0; i < 100; i++)
+			filter(0.6f);
+		for (int i = 0; i < SAMPLES; i++)
+		{
+			float noise = (i * 7919 % 13) / 6.f - 1; //deterministic, spread over -1 to 1
+			double output = filter(0.6f + 0.03f * noise);
+			sum += output;
+			squares += output * output;
+		}
+		double mean = sum / SAMPLES;
+		response.jitter = std::sqrt(squares / SAMPLES - mean * mean);
+		return response;
+	}
+
+	std::string describe(const std::string &name, const StepResponse &response)
+	{
+		std::ostringstream text;
+		text << name << ": step delay " << response.delay * 1000 << " ms, overshoot " << response.overshoot
+			 << ", jitter " << response.jitter;
+		return text.str();
+	}
+
+	typedef AxisFilter<ScaledDeadband, Expo, SlewLimiter> DriveChain;
+	typedef AxisFilter<ScaledDeadband, Expo, OnePole> TwistChain;
+
+	DriveChain shippedDrive()
+	{
+		return DriveChain(ScaledDeadband(DriveConstants::DRIVE_AXIS_DEADBAND)
+						, Expo(DriveConstants::DRIVE_AXIS_EXPO)
+						, SlewLimiter(DriveConstants::DRIVE_AXIS_SLEW));
+	}
+
+	TwistChain shippedTwist()
+	{
+		return TwistChain(ScaledDeadband(DriveConstants::TWIST_AXIS_DEADBAND)
+						, Expo(DriveConstants::TWIST_AXIS_EXPO)
+						, OnePole(DriveConstants::TWIST_AXIS_SMOOTHING));
+	}
+}
+
+TEST_CASE("ScaledDeadband starts at zero at the edge and reaches full stick", "[axisfilter]")
+{
+	ScaledDeadband deadband(0.1f);
+	REQUIRE(deadband(0.05f) == 0);
+	REQUIRE(deadband(-0.1f) == 0);
+	REQUIRE(deadband(0.1001f) < 0.001f);
+	REQUIRE(deadband(1) == Approx(1));
+	REQUIRE(deadband(-1) == Approx(-1));
+	REQUIRE(deadband(0.55f) == Approx(0.5f));
+}
+
+TEST_CASE("Expo keeps the endpoints and softens the middle", "[axisfilter]")
+{
+	Expo expo(0.5f);
+	REQUIRE(expo(1) == Approx(1));
+	REQUIRE(expo(-1) == Approx(-1));
+	REQUIRE(expo(0.5f) == Approx(0.3125f));
+}
+
+TEST_CASE("SlewLimiter and Median3 hold state per axis", "[axisfilter]")
+{
+	SlewLimiter slew(0.25f);
+	REQUIRE(slew(1) == Approx(0.25f));
+	REQUIRE(slew(1) == Approx(0.5f));
+	REQUIRE(slew(-1) == Approx(0.25f));
+	slew.reset();
+	REQUIRE(slew(0.1f) == Approx(0.1f));
+
+	Median3 median;
+	median(0.5f);
+	median(0.5f);
+	REQUIRE(median(1) == Approx(0.5f)); //a one packet spike is dropped
+	REQUIRE(median(0.5f) == Approx(0.5f));
+}
+
+TEST_CASE("AxisFilter runs stages in order without allocating", "[axisfilter]")
+{
+	AxisFilter<ScaledDeadband, Expo, OnePole> filter(ScaledDeadband(0.1f), Expo(0), OnePole(0.5f));
+	REQUIRE(filter.settle(0.55f) == Approx(0.5f));
+
+	std::size_t before = allocationCount();
+	float first = filter(0.55f);
+	float second = filter(0.55f);
+	std::size_t after = allocationCount();
+
+	REQUIRE(after == before);
+	REQUIRE(first == Approx(0.25f));
+	REQUIRE(second == Approx(0.375f));
+	filter.reset();
+	REQUIRE(filter(0.55f) == Approx(0.25f));
+}
+
+TEST_CASE("Axis shaping step response", "[axisfilter]")
+{
+	StepResponse legacy = measure(LegacyAverage());
+	StepResponse drive = measure(shippedDrive());
+	StepResponse twist = measure(shippedTwist());
+	StepResponse raw = measure(AxisFilter<ScaledDeadband>(ScaledDeadband(0.1f)));
+	StepResponse median = measure(AxisFilter<ScaledDeadband, Median3>(ScaledDeadband(0.1f), Median3()));
+	StepResponse gentle = measure(AxisFilter<ScaledDeadband, OnePole>(ScaledDeadband(0.1f), OnePole(0.3f)));
+
+	INFO(describe("legacy 25 sample average", legacy));
+	INFO(describe("drive: deadband, expo, slew", drive));
+	INFO(describe("twist: deadband, expo, one pole", twist));
+	INFO(describe("deadband only", raw));
+	INFO(describe("deadband, median of 3", median));
+	INFO(describe("deadband, one pole 0.3", gentle));
+
+	REQUIRE(legacy.delay > 0.4);
+	REQUIRE(drive.delay <= 0.08);
+	REQUIRE(twist.delay <= 0.08);
+	REQUIRE(drive.overshoot == 0);
+	REQUIRE(twist.overshoot == 0);
+	REQUIRE(twist.jitter < raw.jitter);
+}
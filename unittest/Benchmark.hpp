@@ -0,0 +1,24 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+//runs body() iterations times and returns the average nanoseconds per iteration
+template <typename F>
+double nanosecondsPerIteration(int iterations, F body)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++)
+		body(i);
+	auto stop = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+}
+
+inline void reportBenchmark(const std::string &name, double nanoseconds)
+{
+	std::cout << name << ":\t" << nanoseconds << " ns" << std::endl;
+}
+
+#endif
@@ -0,0 +1,131 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "ButtonConfig.hpp"
+
+namespace
+{
+	struct Counters
+	{
+		int up;
+		int down;
+		int macro;
+		Counters() : up(0), down(0), macro(0) {}
+	};
+
+	ButtonConfig makeConfig(Counters &counters)
+	{
+		ButtonConfig config;
+		config.addDevice("joystick", 0);
+		config.addDevice("gamecube", 1);
+		config.addCommand("lifter.up", [&counters]() { counters.up++; });
+		config.addCommand("lifter.down", [&counters]() { counters.down++; });
+		config.addCommand("lifter.macro", [&counters]() { counters.macro++; });
+		return config;
+	}
+
+	void frame(InputBus &bus, ButtonEdges &edges, int device, uint32_t buttons, double now)
+	{
+		edges.update(buttons);
+		bus.beginFrame();
+		bus.publish(device, edges);
+		bus.dispatch(now);
+	}
+}
+
+TEST_CASE("ButtonConfig builds a dispatch table from text", "[buttonconfig]")
+{
+	Counters counters;
+	ButtonConfig config = makeConfig(counters);
+	std::istringstream text(
+		"# lifter\n"
+		"\n"
+		"joystick TopRight down lifter.up\n"
+		"joystick 4 pressed lifter.down   # BottomRight by number\n"
+		"gamecube TopLeft+Trigger down lifter.macro\n"
+		"gamecube Button9 held 0.3 lifter.up\n");
+	std::vector<std::string> errors;
+	std::unique_ptr<InputBus> bus = config.build(text, errors);
+	REQUIRE(errors.empty());
+	REQUIRE(bus);
+
+	ButtonEdges joystick, gamecube;
+	frame(*bus, joystick, 0, ButtonEdges::bit(TopRight) | ButtonEdges::bit(BottomRight), 0);
+	frame(*bus, joystick, 0, ButtonEdges::bit(BottomRight), 0.02);
+	REQUIRE(counters.up == 1);
+	REQUIRE(counters.down == 1);
+
+	frame(*bus, gamecube, 1, ButtonEdges::bit(TopLeft) | ButtonEdges::bit(Trigger), 0.04);
+	REQUIRE(counters.macro == 1);
+
+	for (double now = 0.06; now < 0.5; now += 0.02)
+		frame(*bus, gamecube, 1, ButtonEdges::bit(Button9), now);
+	REQUIRE(counters.up == 2);
+}
+
+TEST_CASE("ButtonConfig while bindings run every loop the button is held", "[buttonconfig]")
+{
+	Counters counters;
+	ButtonConfig config = makeConfig(counters);
+	std::istringstream text(
+		"joystick TopRight while lifter.up\n"
+		"joystick BottomRight down lifter.down\n");
+	std::vector<std::string> errors;
+	std::unique_ptr<InputBus> bus = config.build(text, errors);
+	REQUIRE(bus);
+
+	ButtonEdges joystick;
+	const uint32_t BOTH = ButtonEdges::bit(TopRight) | ButtonEdges::bit(BottomRight);
+	for (int loop = 0; loop < 10; loop++)
+		frame(*bus, joystick, 0, BOTH, loop * 0.02);
+	frame(*bus, joystick, 0, 0, 0.2);
+	REQUIRE(counters.up == 10);
+	REQUIRE(counters.down == 1);
+}
+
+TEST_CASE("ButtonConfig reports every bad line and builds nothing", "[buttonconfig]")
+{
+	Counters counters;
+	ButtonConfig config = makeConfig(counters);
+	std::istringstream text(
+		"joystick TopRight down lifter.up\n"
+		"operator TopRight down lifter.up\n"
+		"joystick Button13 down lifter.up\n"
+		"joystick TopRight sideways lifter.up\n"
+		"joystick TopRight down lifter.sideways\n"
+		"joystick TopRight+Trigger up lifter.up\n"
+		"joystick TopRight held lifter.up\n"
+		"joystick TopRight\n"
+		"joystick TopRight+Trigger while lifter.up\n");
+	std::vector<std::string> errors;
+	REQUIRE_FALSE(config.build(text, errors));
+	REQUIRE(errors.size() == 8);
+	REQUIRE(errors[0] == "line 2: unknown device 'operator'");
+	REQUIRE(errors[1] == "line 3: unknown button 'Button13'");
+	REQUIRE(errors[4].find("line 6") == 0);
+	REQUIRE(errors[6].find("line 8") == 0);
+}
+
+TEST_CASE("ButtonConfig notices when its file changes", "[buttonconfig]")
+{
+	Counters counters;
+	ButtonConfig config = makeConfig(counters);
+	const char *file = "button_config_test.cfg";
+	std::ofstream(file) << "joystick TopRight down lifter.up\n";
+
+	REQUIRE(config.changed(file));
+	std::vector<std::string> errors;
+	REQUIRE(config.load(file, errors));
+	REQUIRE_FALSE(config.changed(file));
+
+	std::ofstream(file) << "joystick TopRight down lifter.down\njoystick TopLeft down lifter.up\n";
+	REQUIRE(config.changed(file));
+	REQUIRE(config.load(file, errors));
+	REQUIRE(errors.empty());
+
+	std::remove(file);
+	REQUIRE_FALSE(config.changed(file));
+	REQUIRE_FALSE(config.load(file, errors));
+	REQUIRE(errors.size() == 1);
+}
@@ -0,0 +1,116 @@
+#include <catch.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "ButtonEdges.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+	const int BUTTONS = 12;
+
+	struct LegacyButton
+	{
+		bool down, pressed, up;
+	};
+
+	//what the driver station does for each Joystick::GetRawButton() call
+	__attribute__((noinline)) bool getRawButton(const uint32_t *word, const uint8_t *count, int button)
+	{
+		if (button <= 0 || button > *count)
+			return false;
+		return ((1u << (button - 1)) & *word) != 0;
+	}
+
+	//JoystickWrapper::pollJoystick() before edges were computed from the button word
+	void legacyPoll(std::array<LegacyButton, BUTTONS> &buttons, const uint32_t *word, const uint8_t *count)
+	{
+		for (int i = 0; i < BUTTONS && i < *count; i++)
+		{
+			LegacyButton b = buttons[i];
+			buttons[i].up = (b.down || b.pressed) && !b.up && !getRawButton(word, count, i + 1);
+			b = buttons[i];
+			buttons[i].pressed = (b.down || b.pressed) && !b.up && getRawButton(word, count, i + 1);
+			b = buttons[i];
+			buttons[i].down = !b.down && !b.pressed && getRawButton(word, count, i + 1);
+		}
+	}
+
+	std::vector<uint32_t> buttonSequence(int length)
+	{
+		std::vector<uint32_t> words;
+		uint32_t state = 12345;
+		for (int i = 0; i < length; i++)
+		{
+			state = state * 1103515245u + 12345u;
+			words.push_back((state >> 8) & 0xfff);
+		}
+		return words;
+	}
+}
+
+TEST_CASE("ButtonEdges reports down once, pressed while held, then up once", "[buttonedges]")
+{
+	ButtonEdges edges;
+	edges.update(ButtonEdges::bit(3));
+	REQUIRE(edges.isDown(3));
+	REQUIRE_FALSE(edges.isPressed(3));
+
+	edges.update(ButtonEdges::bit(3));
+	REQUIRE_FALSE(edges.isDown(3));
+	REQUIRE(edges.isPressed(3));
+
+	edges.update(0);
+	REQUIRE(edges.isUp(3));
+	REQUIRE_FALSE(edges.isPressed(3));
+
+	edges.update(0);
+	REQUIRE(edges.any() == 0);
+}
+
+TEST_CASE("ButtonEdges matches the per-button checks it replaced", "[buttonedges]")
+{
+	std::array<LegacyButton, BUTTONS> legacy = {};
+	ButtonEdges edges;
+	uint8_t count = BUTTONS;
+
+	for (uint32_t word : buttonSequence(2000))
+	{
+		legacyPoll(legacy, &word, &count);
+		edges.update(word);
+		for (int i = 0; i < BUTTONS; i++)
+		{
+			REQUIRE(legacy[i].down == edges.isDown(i + 1));
+			REQUIRE(legacy[i].pressed == edges.isPressed(i + 1));
+			REQUIRE(legacy[i].up == edges.isUp(i + 1));
+		}
+	}
+}
+
+TEST_CASE("Joystick poll cost", "[.][benchmark]")
+{
+	std::vector<uint32_t> words = buttonSequence(1024);
+	uint8_t count = BUTTONS;
+	uint32_t sink = 0;
+
+	std::array<LegacyButton, BUTTONS> legacy = {};
+	double before = nanosecondsPerIteration(1000000, [&](int i)
+	{
+		legacyPoll(legacy, &words[i & 1023], &count);
+		sink += legacy[i % BUTTONS].down;
+	});
+
+	ButtonEdges edges;
+	double after = nanosecondsPerIteration(1000000, [&](int i)
+	{
+		uint32_t word = words[i & 1023];
+		sink += getRawButton(&word, &count, i % BUTTONS + 1); //the one driver station read, of a real button so it does the bit test
+		edges.update(word);
+		sink += edges.down;
+	});
+
+	reportBenchmark("poll, three GetRawButton checks per button", before);
+	reportBenchmark("poll, one button word and bitmasks", after);
+	REQUIRE(sink != 1);
+	REQUIRE(after < before);
+}
@@ -0,0 +1,111 @@
+#include <catch.hpp>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "ControlThread.hpp"
+#include "SpscQueue.hpp"
+
+TEST_CASE("SpscQueue hands values across threads in order", "[spscqueue]") {
+	SpscQueue<int, 64> queue;
+	const int COUNT = 100000;
+
+	std::thread producer([&] () {
+		for (int i = 0; i < COUNT; i++)
+		{
+			while (!queue.push(i))
+				std::this_thread::yield();
+		}
+	});
+
+	bool inOrder = true;
+	int expected = 0;
+	while (expected < COUNT)
+	{
+		int value = 0;
+		if (queue.pop(value))
+		{
+			inOrder = inOrder && value == expected;
+			expected++;
+		}
+	}
+	producer.join();
+
+	REQUIRE(inOrder);
+	REQUIRE(queue.size() == 0);
+}
+
+TEST_CASE("SpscQueue reports full and empty", "[spscqueue]") {
+	SpscQueue<int, 4> queue;
+	int value;
+	REQUIRE_FALSE(queue.pop(value));
+	for (int i = 0; i < 4; i++)
+		REQUIRE(queue.push(i));
+	REQUIRE_FALSE(queue.push(4));
+	REQUIRE(queue.pop(value));
+	REQUIRE(value == 0);
+	REQUIRE(queue.push(4));
+	REQUIRE(queue.size() == 4);
+}
+
+TEST_CASE("ControlThread steps until stopped and keeps consistent statistics", "[controlthread]") {
+	std::atomic<int> steps(0);
+	ControlThread thread(200, [&] () { steps++; });
+	REQUIRE(thread.getRate() == Approx(200));
+
+	REQUIRE(thread.start());
+	REQUIRE_FALSE(thread.start());
+	while (steps < 20)
+		std::this_thread::yield();
+	thread.stop();
+
+	//periods are measured between step starts, so there is one fewer than there were steps
+	ControlThread::Stats stats = thread.getStats();
+	REQUIRE_FALSE(thread.isRunning());
+	REQUIRE(stats.iterations == steps - 1);
+	REQUIRE(stats.minPeriod > 0);
+	REQUIRE(stats.minPeriod <= stats.meanPeriod);
+	REQUIRE(stats.maxPeriod >= stats.meanPeriod);
+
+	thread.resetStats();
+	REQUIRE(thread.getStats().iterations == 0);
+}
+
+TEST_CASE("ControlThread counts a step that runs past the next tick as an overrun", "[controlthread]") {
+	std::atomic<int> steps(0);
+	ControlThread thread(1000, [&] () {
+		if (steps++ == 10)
+			std::this_thread::sleep_for(std::chrono::milliseconds(20)); //always longer than the 1 ms period
+	});
+
+	thread.start();
+	while (steps < 15)
+		std::this_thread::yield();
+	thread.stop();
+
+	REQUIRE(thread.getStats().overruns >= 1);
+}
+
+TEST_CASE("ControlThread skips ticks it overran instead of bursting", "[controlthread]") {
+	//due at 1000 with a period of 1000, a step that finished at 21500 missed every tick up to 21000
+	REQUIRE(ControlThread::skipMissedTicks(1000, 21500, 1000) == 22000);
+	REQUIRE(ControlThread::skipMissedTicks(1000, 1001, 1000) == 2000);
+	//finishing exactly on a tick is too late to start it on time
+	REQUIRE(ControlThread::skipMissedTicks(1000, 3000, 1000) == 4000);
+	//the grid stays where it was, so timing errors don't accumulate
+	REQUIRE(ControlThread::skipMissedTicks(1250, 7900, 500) == 8250);
+}
+
+TEST_CASE("ControlThread timing at 200 Hz", "[.][benchmark]") {
+	std::atomic<int> steps(0);
+	ControlThread thread(200, [&] () { steps++; });
+	thread.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(500));
+	thread.stop();
+
+	ControlThread::Stats stats = thread.getStats();
+	std::cout << "200 Hz control thread: " << stats.iterations << " iterations in 500 ms, mean period "
+	          << stats.meanPeriod * 1000 << " ms, max jitter " << stats.maxJitter * 1000 << " ms, "
+	          << stats.overruns << " overruns, real-time " << thread.hasRealtimePriority() << std::endl;
+	REQUIRE(stats.iterations == steps - 1);
+}
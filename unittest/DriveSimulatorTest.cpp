@@ -0,0 +1,216 @@
+#include <catch.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include <unistd.h>
+#include "sim/DriveSimulator.hpp"
+#include "sim/DrivetrainModel.hpp"
+#include "DriveAuto.hpp"
+#include "Shifter.hpp"
+#include "AutoPaths.hpp"
+#include "TrajectoryCache.hpp"
+
+namespace
+{
+	const double PI = 3.14159265358979;
+
+	//drives the bare model with fixed outputs, no robot code involved
+	DrivetrainModel drive(double left, double right, bool highGear, double seconds)
+	{
+		DrivetrainModel model(defaultDrivetrain());
+		for (double t = 0; t < seconds; t += DriveSimulator::PHYSICS_PERIOD)
+			model.step(left, right, highGear, DriveSimulator::PHYSICS_PERIOD);
+		return model;
+	}
+
+	DriveSimulator& simulator()
+	{
+		static DriveSimulator instance(defaultDrivetrain());
+		instance.reset();
+		return instance;
+	}
+
+	double poseError(const Pose &pose, double x, double y)
+	{
+		return std::hypot(pose.x - x, pose.y - y);
+	}
+
+	double headingError(const Pose &pose, double heading)
+	{
+		double error = std::fmod(pose.heading - heading + 540, 360) - 180;
+		return std::abs(error);
+	}
+
+	struct AutoScript
+	{
+		const char *name;
+		std::function<void()> queue;
+		Pose expected;
+	};
+}
+
+TEST_CASE("DrivetrainModel top speed depends on the Shifter gear", "[sim]")
+{
+	DrivetrainModel low = drive(1, 1, false, 3);
+	DrivetrainModel high = drive(1, 1, true, 3);
+
+	REQUIRE(low.getVelocity() > 110);
+	REQUIRE(low.getVelocity() < 135);
+	REQUIRE(high.getVelocity() > low.getVelocity() * 1.5);
+	REQUIRE(std::abs(low.getY()) < 0.01);
+	REQUIRE(std::abs(low.getHeading()) < 0.01);
+}
+
+TEST_CASE("DrivetrainModel wheels slip under hard acceleration", "[sim]")
+{
+	DrivetrainModel gentle = drive(0.3, 0.3, false, 1);
+	DrivetrainModel hard = drive(1, 1, false, 1);
+
+	INFO("gentle " << gentle.getMaxSlip() << " hard " << hard.getMaxSlip());
+	REQUIRE(gentle.getMaxSlip() < 2);
+	REQUIRE(hard.getMaxSlip() > 10);
+
+	//the encoders read the wheels, so a slipping wheel reads further than the robot went
+	REQUIRE(hard.getLeftDistance() > hard.getX());
+	REQUIRE(gentle.getLeftDistance() == Approx(gentle.getX()).epsilon(0.01));
+}
+
+TEST_CASE("DrivetrainModel turns in place with opposite outputs", "[sim]")
+{
+	DrivetrainModel model = drive(-0.5, 0.5, false, 1);
+
+	REQUIRE(model.getHeading() > 90);
+	REQUIRE(std::abs(model.getX()) < 0.1);
+	REQUIRE(std::abs(model.getY()) < 0.1);
+
+	//scrub stops a low output from turning at all
+	DrivetrainModel stuck = drive(-0.02, 0.02, false, 1);
+	REQUIRE(std::abs(stuck.getHeading()) < 0.01);
+}
+
+//how much faster than real time the simulator runs is in the script suite's x real column
+TEST_CASE("DriveAuto moves in the simulator", "[sim]")
+{
+	DriveSimulator &sim = simulator();
+	SimulationResult result = sim.run([] { DriveAuto::get()->move(72, 0.5); }, 10);
+
+	REQUIRE(result.finished);
+	REQUIRE(poseError(result.pose, 72, 0) < 2);
+}
+
+TEST_CASE("DriveAuto turns in the simulator", "[sim]")
+{
+	DriveSimulator &sim = simulator();
+	SimulationResult result = sim.run([] { DriveAuto::get()->axisTurn(90); }, 10);
+
+	//turns are positive to the right, the model's heading is counterclockwise
+	REQUIRE(result.finished);
+	REQUIRE(headingError(result.pose, -90) < 3);
+	REQUIRE(poseError(result.pose, 0, 0) < 2);
+}
+
+TEST_CASE("DriveAuto moves turned away by a full queue leave queued profiles alone", "[sim]")
+{
+	DriveSimulator &sim = simulator();
+	SimulationResult result = sim.run([]
+	{
+		DriveAuto::get()->move(24, 0.5);
+		for (int i = 1; i < 32; i++) //fills DriveAuto's 32 entry action queue
+			DriveAuto::get()->wait(0);
+		//more rejected moves than there are profile slots, so a round robin would come back to the queued move's
+		for (int i = 0; i < 10; i++)
+			DriveAuto::get()->move(120, 0.5);
+	}, 10);
+
+	REQUIRE(result.finished);
+	REQUIRE(poseError(result.pose, 24, 0) < 2);
+}
+
+TEST_CASE("DriveAuto reuses its four PID controllers across moves and tote aligns", "[sim]")
+{
+	DriveSimulator &sim = simulator();
+	REQUIRE(DriveAuto::getLiveControllerCount() == 4);
+
+	for (int cycle = 0; cycle < 5; cycle++)
+	{
+		sim.run([] { DriveAuto::get()->move(24, 0.5); }, 5);
+		REQUIRE(DriveAuto::getLiveControllerCount() == 4);
+
+		//a tote align stays queued until it is cleared, so give it a few updates and move on
+		sim.run([] { DriveAuto::get()->toteAlign(); }, 0.2);
+		REQUIRE(DriveAuto::getLiveControllerCount() == 4);
+		sim.reset();
+	}
+}
+
+TEST_CASE("Autonomous script suite", "[.][benchmark]")
+{
+	char file[] = "/tmp/sim_trajectoriesXXXXXX";
+	int fd = mkstemp(file);
+	REQUIRE(fd >= 0);
+	close(fd);
+	TrajectoryCache trajectories;
+	TrajectoryCache::write(file, AutoPaths::build());
+	trajectories.open(file);
+	std::vector<PursuitPoint> sweepPoints = AutoPaths::buildSweepPursuit();
+	PursuitPath sweepPath = { sweepPoints.data(), static_cast<int>(sweepPoints.size()) };
+	Shifter shifter(0, 1);
+
+	std::vector<AutoScript> scripts = {
+		{ "move 72, turn 90, wait 1, move 100", [&] {
+			shifter.shiftLow();
+			DriveAuto::get()->setBlending(true);
+			DriveAuto::get()->move(72, 0.5);
+			DriveAuto::get()->axisTurn(90);
+			DriveAuto::get()->wait(1);
+			DriveAuto::get()->move(100, 0.75);
+		}, { 72, -100, -90 } },
+		{ "AutoZone trajectory", [&] {
+			shifter.shiftLow();
+			DriveAuto::get()->followTrajectory(trajectories.find("AutoZone"));
+		}, { 100, 0, 0 } },
+		{ "SweepRight trajectory", [&] {
+			shifter.shiftLow();
+			DriveAuto::get()->followTrajectory(trajectories.find("SweepRight"));
+		}, { 120, -60, 0 } },
+		{ "SweepRight pure pursuit", [&] {
+			shifter.shiftLow();
+			DriveAuto::get()->followPath(&sweepPath);
+		}, { 120, -60, 0 } },
+		{ "zigzag, blending off", [&] {
+			shifter.shiftLow();
+			DriveAuto::get()->setBlending(false);
+			DriveAuto::get()->move(48, 1);
+			DriveAuto::get()->axisTurn(45);
+			DriveAuto::get()->move(48, 1);
+			DriveAuto::get()->axisTurn(-45);
+			DriveAuto::get()->move(48, 1);
+		}, { 96 + 48 * std::cos(PI / 4), -48 * std::sin(PI / 4), 0 } },
+		{ "zigzag, blending on", [&] {
+			shifter.shiftLow();
+			DriveAuto::get()->setBlending(true);
+			DriveAuto::get()->move(48, 1);
+			DriveAuto::get()->axisTurn(45);
+			DriveAuto::get()->move(48, 1);
+			DriveAuto::get()->axisTurn(-45);
+			DriveAuto::get()->move(48, 1);
+		}, { 96 + 48 * std::cos(PI / 4), -48 * std::sin(PI / 4), 0 } },
+	};
+
+	std::printf("%-36s %8s %10s %10s %10s %10s\n", "script", "time s", "error in", "error deg", "us/cycle", "x real");
+	for (const AutoScript &script : scripts)
+	{
+		DriveSimulator &sim = simulator();
+		SimulationResult result = sim.run(script.queue, 20);
+		std::printf("%-36s %8.2f %10.2f %10.2f %10.2f %10.0f%s\n", script.name, result.seconds,
+		            poseError(result.pose, script.expected.x, script.expected.y),
+		            headingError(result.pose, script.expected.heading),
+		            result.cycleMicros, result.realTimeFactor, result.finished ? "" : " (timed out)");
+	}
+	DriveAuto::get()->setBlending(true);
+	trajectories.close();
+	std::remove(file);
+}
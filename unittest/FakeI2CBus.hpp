@@ -0,0 +1,88 @@
+#ifndef FAKE_I2C_BUS_HPP
+#define FAKE_I2C_BUS_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "I2CDevice.hpp"
+#include "FakeLidarLite.hpp"
+
+//several fake Lidar-Lites on one bus, a transfer NAKs when no powered unit or more than one answers the address
+class FakeI2CBus
+{
+public:
+	std::vector<std::unique_ptr<FakeLidarLite>> units;
+	int transfers;
+	int collisions;
+
+	FakeI2CBus()
+		: transfers(0)
+		, collisions(0)
+	{
+	}
+
+	FakeLidarLite* addUnit(uint16_t serial)
+	{
+		units.push_back(std::unique_ptr<FakeLidarLite>(new FakeLidarLite()));
+		units.back()->serial = serial;
+		return units.back().get();
+	}
+
+	void setTime(double now)
+	{
+		for (const std::unique_ptr<FakeLidarLite> &unit : units)
+			unit->now = now;
+	}
+
+	std::unique_ptr<I2CDevice> open(uint8_t address)
+	{
+		return std::unique_ptr<I2CDevice>(new Handle(this, address));
+	}
+
+private:
+	class Handle : public I2CDevice
+	{
+	public:
+		Handle(FakeI2CBus *bus, uint8_t address)
+			: bus(bus)
+			, address(address)
+		{
+		}
+
+		virtual bool write(uint8_t registerAddress, uint8_t data)
+		{
+			FakeLidarLite *unit = bus->route(address);
+			return unit == nullptr || unit->write(registerAddress, data);
+		}
+
+		virtual bool read(uint8_t registerAddress, uint8_t count, uint8_t *buffer)
+		{
+			FakeLidarLite *unit = bus->route(address);
+			return unit == nullptr || unit->read(registerAddress, count, buffer);
+		}
+
+	private:
+		FakeI2CBus *bus;
+		uint8_t address;
+	};
+
+	FakeLidarLite* route(uint8_t address)
+	{
+		transfers++;
+		FakeLidarLite *found = nullptr;
+		for (const std::unique_ptr<FakeLidarLite> &unit : units)
+		{
+			if (!unit->powered || unit->address != address)
+				continue;
+			if (found != nullptr)
+			{
+				collisions++;
+				return nullptr;
+			}
+			found = unit.get();
+		}
+		return found;
+	}
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef FAKE_LIDAR_LITE_HPP
+#define FAKE_LIDAR_LITE_HPP
+
+#include <cstdint>
+#include "I2CDevice.hpp"
+
+//stands in for a Lidar-Lite on the bus, NAKing reads while a measurement is running like the real sensor
+//and taking a new address when sent its serial number
+class FakeLidarLite : public I2CDevice
+{
+public:
+	double now;            //moved along by the test with the times it gives the driver
+	double measureSeconds;
+	uint16_t centimeters;  //what the next triggered measurement will read
+	int abortWrites;       //aborts this many writes before acknowledging again
+	uint8_t address;       //where FakeI2CBus routes transfers to it
+	uint16_t serial;
+	bool powered;
+	int writes;
+	int reads;
+	int abortedReads;
+
+	FakeLidarLite()
+		: now(0)
+		, measureSeconds(0.02)
+		, centimeters(0)
+		, abortWrites(0)
+		, address(0x62)
+		, serial(0)
+		, powered(true)
+		, writes(0)
+		, reads(0)
+		, abortedReads(0)
+		, measuring(false)
+		, triggeredAt(0)
+		, measured(0)
+		, serialHigh(0)
+		, serialLow(0)
+		, newAddress(0)
+	{
+	}
+
+	virtual bool write(uint8_t registerAddress, uint8_t data)
+	{
+		writes++;
+		if (abortWrites > 0)
+		{
+			abortWrites--;
+			return true;
+		}
+		if (registerAddress == 0x00 && data == 0x04)
+		{
+			measuring = true;
+			triggeredAt = now;
+			measured = centimeters;
+		}
+		else if (registerAddress == 0x18)
+			serialHigh = data;
+		else if (registerAddress == 0x19)
+			serialLow = data;
+		else if (registerAddress == 0x1a)
+			newAddress = data;
+		else if (registerAddress == 0x1e && data == 0x08 && (serialHigh << 8 | serialLow) == serial)
+			address = newAddress;
+		return false;
+	}
+
+	virtual bool read(uint8_t registerAddress, uint8_t count, uint8_t *buffer)
+	{
+		reads++;
+		if (registerAddress == 0x96 && count == 2)
+		{
+			buffer[0] = serial >> 8;
+			buffer[1] = serial & 0xff;
+			return false;
+		}
+		//a little slack so rounding in the test's clock doesn't NAK a measurement that is just done
+		if (!measuring || now - triggeredAt < measureSeconds - 1e-9 || registerAddress != 0x8f || count != 2)
+		{
+			abortedReads++;
+			return true;
+		}
+		buffer[0] = measured >> 8;
+		buffer[1] = measured & 0xff;
+		return false;
+	}
+
+private:
+	bool measuring;
+	double triggeredAt;
+	uint16_t measured;
+	uint8_t serialHigh;
+	uint8_t serialLow;
+	uint8_t newAddress;
+};
+
+#endif
@@ -0,0 +1,213 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "FilterBank.hpp"
+#include "MovingAverage.hpp"
+#include "Benchmark.hpp"
+#include "AllocationCounter.hpp"
+
+namespace
+{
+	//one channel the obvious way: FIR over a deque, then each biquad in turn
+	struct ScalarFilter
+	{
+		std::vector<float> fir;
+		std::vector<Biquad> biquads;
+		std::deque<float> history;
+		std::vector<float> z1, z2;
+
+		ScalarFilter(const std::vector<float> &fir, const std::vector<Biquad> &biquads)
+			: fir(fir)
+			, biquads(biquads)
+			, history(fir.size(), 0.f)
+			, z1(biquads.size(), 0.f)
+			, z2(biquads.size(), 0.f)
+		{
+		}
+
+		float operator()(float x)
+		{
+			history.push_front(x);
+			history.pop_back();
+			float y = 0;
+			for (std::size_t tap = 0; tap < fir.size(); tap++)
+				y += fir[tap] * history[tap];
+
+			for (std::size_t i = 0; i < biquads.size(); i++)
+			{
+				const Biquad &b = biquads[i];
+				float in = y;
+				y = b.b0 * in + z1[i];
+				z1[i] = b.b1 * in - b.a1 * y + z2[i];
+				z2[i] = b.b2 * in - b.a2 * y;
+			}
+			return y;
+		}
+	};
+
+	Biquad randomLowPass(std::mt19937 &random)
+	{
+		std::uniform_real_distribution<double> cutoff(1, 20);
+		return Biquad::lowPass(cutoff(random), 100);
+	}
+}
+
+TEST_CASE("FilterBank channels match filtering each one on its own", "[filterbank]")
+{
+	const int CHANNELS = 7; //not a multiple of the lane count
+	const int TAPS = 5;
+	const int SECTIONS = 2;
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> coefficient(-0.5f, 0.5f);
+	std::uniform_real_distribution<float> signal(-100, 100);
+
+	FilterBank bank(CHANNELS, TAPS, SECTIONS);
+	std::vector<ScalarFilter> references;
+	for (int channel = 0; channel < CHANNELS; channel++)
+	{
+		std::vector<float> fir(TAPS);
+		for (float &c : fir)
+			c = coefficient(random);
+		std::vector<Biquad> biquads;
+		for (int section = 0; section < SECTIONS; section++)
+			biquads.push_back(randomLowPass(random));
+
+		bank.setFir(channel, fir.data(), TAPS);
+		for (int section = 0; section < SECTIONS; section++)
+			bank.setBiquad(channel, section, biquads[section]);
+		references.push_back(ScalarFilter(fir, biquads));
+	}
+
+	float worst = 0;
+	for (int i = 0; i < 1000; i++)
+	{
+		std::vector<float> samples;
+		for (int channel = 0; channel < CHANNELS; channel++)
+		{
+			samples.push_back(signal(random) + channel * 10);
+			bank.input(channel, samples.back());
+		}
+		bank.step();
+		for (int channel = 0; channel < CHANNELS; channel++)
+			worst = std::max(worst, std::abs(bank.output(channel) - references[channel](samples[channel])));
+	}
+	INFO("kernel " << FilterBank::kernel());
+	REQUIRE(worst < 1e-3f);
+}
+
+TEST_CASE("FilterBank starts as pass-through and matches MovingAverage once set", "[filterbank]")
+{
+	FilterBank bank(2, 4, 1);
+	MovingAverage<double> average(4);
+	bank.setMovingAverage(1, 4);
+
+	bool matches = true;
+	for (int i = 1; i <= 20; i++)
+	{
+		float sample = (i * 13) % 7;
+		bank.input(0, sample);
+		bank.input(1, sample);
+		bank.step();
+		average.giveRawValue(sample);
+
+		if (bank.output(0) != sample)
+			matches = false;
+		//the FIR averages zeros until the window fills, MovingAverage averages what it has
+		if (i >= 4 && std::abs(bank.output(1) - average.computeAverage()) > 1e-5)
+			matches = false;
+	}
+	REQUIRE(matches);
+}
+
+TEST_CASE("Biquad low pass keeps DC and cuts noise", "[filterbank]")
+{
+	FilterBank bank(1, 1, 2);
+	Biquad lowPass = Biquad::lowPass(5, 100);
+	bank.setBiquad(0, 0, lowPass);
+	bank.setBiquad(0, 1, lowPass);
+
+	for (int i = 0; i < 500; i++)
+	{
+		bank.input(0, 50);
+		bank.step();
+	}
+	float dc = bank.output(0);
+	REQUIRE(std::abs(dc - 50) < 1e-3f);
+
+	//alternating samples are at the Nyquist frequency, which a low pass zeroes
+	float largest = 0;
+	for (int i = 0; i < 500; i++)
+	{
+		bank.input(0, i % 2 == 0 ? 10.f : -10.f);
+		bank.step();
+		if (i > 400)
+			largest = std::max(largest, std::abs(bank.output(0)));
+	}
+	REQUIRE(largest < 0.01f);
+}
+
+TEST_CASE("FilterBank step doesn't allocate", "[filterbank]")
+{
+	FilterBank bank(32, 8, 2);
+	std::size_t before = allocationCount();
+	for (int i = 0; i < 100; i++)
+	{
+		for (int channel = 0; channel < 32; channel++)
+			bank.input(channel, i + channel);
+		bank.step();
+	}
+	std::size_t allocations = allocationCount() - before;
+	REQUIRE(allocations == 0);
+}
+
+TEST_CASE("FilterBank against filtering channels one at a time", "[.][benchmark]")
+{
+	const int CHANNEL_COUNTS[] = { 8, 32, 128 };
+	const int TAPS = 8;
+	const int SECTIONS = 2;
+	const int STEPS = 20000;
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> signal(-1, 1);
+	std::vector<float> samples(4096);
+	for (float &sample : samples)
+		sample = signal(random);
+
+	std::cout << "FilterBank kernel:\t" << FilterBank::kernel() << std::endl;
+	for (int channels : CHANNEL_COUNTS)
+	{
+		std::vector<float> fir(TAPS, 1.f / TAPS);
+		std::vector<Biquad> biquads(SECTIONS, Biquad::lowPass(8, 50));
+		std::vector<ScalarFilter> scalar(channels, ScalarFilter(fir, biquads));
+		FilterBank bank(channels, TAPS, SECTIONS);
+		for (int channel = 0; channel < channels; channel++)
+		{
+			bank.setMovingAverage(channel, TAPS);
+			for (int section = 0; section < SECTIONS; section++)
+				bank.setBiquad(channel, section, biquads[section]);
+		}
+
+		float sink = 0;
+		double scalarNs = nanosecondsPerIteration(STEPS, [&](int i)
+		{
+			for (int channel = 0; channel < channels; channel++)
+				sink += scalar[channel](samples[(i + channel) & 4095]);
+		});
+		double bankNs = nanosecondsPerIteration(STEPS, [&](int i)
+		{
+			for (int channel = 0; channel < channels; channel++)
+				bank.input(channel, samples[(i + channel) & 4095]);
+			bank.step();
+			sink += bank.output(0);
+		});
+
+		std::string size = std::to_string(channels) + " channels";
+		reportBenchmark("per channel filters, " + size, scalarNs);
+		reportBenchmark("FilterBank, " + size, bankNs);
+		REQUIRE(sink == sink);
+	}
+}
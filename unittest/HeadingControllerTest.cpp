@@ -0,0 +1,119 @@
+#include <catch.hpp>
+#include <cmath>
+#include "HeadingController.hpp"
+#include "DriveConstants.hpp"
+
+using namespace DriveConstants;
+
+namespace
+{
+	//robot rotation: output drives the turn rate toward output * fullRate
+	struct SimulatedRotation
+	{
+		float heading;
+		float rate;
+		float fullRate;
+		float timeConstant;
+
+		SimulatedRotation(float fullRate, float timeConstant)
+			: heading(0), rate(0), fullRate(fullRate), timeConstant(timeConstant) {}
+
+		void step(float output, float dt)
+		{
+			rate += (output * fullRate - rate) / timeConstant * dt;
+			heading += rate * dt;
+		}
+	};
+
+	const float SIM_DT = 0.001f;
+	const float LOOP_PERIOD = 0.02f;
+
+	HeadingController controller()
+	{
+		return HeadingController(TURN_MAX_RATE, TURN_MAX_ACCELERATION, TURN_KV, TURN_KP, TURN_KD, TURN_MIN_OUTPUT,
+		                         TURN_TOLERANCE, TURN_SETTLE_TIME, TURN_TIMEOUT);
+	}
+
+	TurnReport closedLoopTurn(float degrees, SimulatedRotation robot)
+	{
+		HeadingController turn = controller();
+		turn.start(robot.heading, degrees, 0);
+		float output = 0;
+		float t = 0, nextLoop = 0;
+		while (!turn.isFinished() && t < 10)
+		{
+			if (t >= nextLoop)
+			{
+				output = turn.calculate(robot.heading, t);
+				nextLoop += LOOP_PERIOD;
+			}
+			robot.step(output, SIM_DT);
+			t += SIM_DT;
+		}
+		return turn.getReport();
+	}
+
+	//old DriveAuto axis turn: 0.35 output until past a fudged target
+	TurnReport bangBangTurn(float degrees, SimulatedRotation robot)
+	{
+		const float TURN_SPEED = 0.35f;
+		float wanted = degrees - TURN_SPEED * 100 * (degrees / 180);
+		float output = TURN_SPEED;
+		float t = 0, nextLoop = 0;
+		while (t < 10)
+		{
+			if (t >= nextLoop)
+			{
+				if (robot.heading > wanted)
+					output = 0;
+				nextLoop += LOOP_PERIOD;
+			}
+			robot.step(output, SIM_DT);
+			t += SIM_DT;
+			if (output == 0 && std::abs(robot.rate) < 1.f)
+				break;
+		}
+		TurnReport report = { degrees, degrees - robot.heading, t, false };
+		return report;
+	}
+}
+
+TEST_CASE("Heading controller settles inside tolerance", "[headingcontroller]") {
+	SimulatedRotation robot(550, 0.15f);
+	TurnReport right = closedLoopTurn(90, robot);
+	TurnReport left = closedLoopTurn(-45, robot);
+
+	REQUIRE_FALSE(right.timedOut);
+	REQUIRE(std::abs(right.finalError) < TURN_TOLERANCE);
+	REQUIRE(right.target == 90);
+	REQUIRE_FALSE(left.timedOut);
+	REQUIRE(std::abs(left.finalError) < TURN_TOLERANCE);
+}
+
+TEST_CASE("Heading controller is faster and more repeatable than the bang-bang turn", "[headingcontroller][simulation]") {
+	const float timeConstants[] = { 0.1f, 0.15f, 0.25f };
+	float worstClosedError = 0, worstBangError = 0;
+	for (float tau : timeConstants)
+	{
+		SimulatedRotation robot(550, tau);
+		TurnReport closed = closedLoopTurn(90, robot);
+		TurnReport bang = bangBangTurn(90, robot);
+		INFO("90 degree turn, tau " << tau << ": closed loop " << closed.seconds << " s error " << closed.finalError
+		     << ", bang-bang " << bang.seconds << " s error " << bang.finalError);
+
+		REQUIRE(closed.seconds < bang.seconds);
+		worstClosedError = std::max(worstClosedError, std::abs(closed.finalError));
+		worstBangError = std::max(worstBangError, std::abs(bang.finalError));
+	}
+
+	REQUIRE(worstClosedError < TURN_TOLERANCE);
+	REQUIRE(worstClosedError < worstBangError);
+}
+
+TEST_CASE("Heading controller gives up when the robot cannot turn", "[headingcontroller]") {
+	SimulatedRotation stuck(0, 0.15f);
+	TurnReport report = closedLoopTurn(90, stuck);
+
+	REQUIRE(report.timedOut);
+	REQUIRE(report.finalError == Approx(90));
+}
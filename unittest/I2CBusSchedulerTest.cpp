@@ -0,0 +1,128 @@
+#include <catch.hpp>
+#include <memory>
+#include <vector>
+#include "I2CBusScheduler.hpp"
+#include "LidarI2C.hpp"
+#include "FakeI2CBus.hpp"
+#include "AllocationCounter.hpp"
+
+namespace
+{
+	const double SLICE = 0.005; //the bus is serviced at 200 Hz
+	const uint8_t ADDRESSES[] = { 0x64, 0x66, 0x68, 0x6a };
+
+	//four units powered up one at a time and moved off the default address, the way the robot brings them up
+	struct Rig
+	{
+		FakeI2CBus bus;
+		std::vector<std::unique_ptr<LidarI2C>> lidars;
+
+		Rig()
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				FakeLidarLite *unit = bus.addUnit(0x1000 + i);
+				unit->powered = false;
+				unit->centimeters = 100 * (i + 1);
+			}
+			for (int i = 0; i < 4; i++)
+			{
+				bus.units[i]->powered = true;
+				std::unique_ptr<I2CDevice> atDefault = bus.open(LidarI2C::DEFAULT_ADDRESS);
+				LidarI2C::changeAddress(*atDefault, ADDRESSES[i]);
+				lidars.push_back(std::unique_ptr<LidarI2C>(new LidarI2C(bus.open(ADDRESSES[i]))));
+			}
+		}
+
+		void run(I2CBusScheduler &scheduler, double seconds)
+		{
+			scheduler.resetStats(0);
+			for (int slice = 0; slice * SLICE < seconds; slice++)
+			{
+				bus.setTime(slice * SLICE);
+				scheduler.update(slice * SLICE);
+			}
+		}
+	};
+}
+
+TEST_CASE("LidarI2C changeAddress moves one sensor at a time off the default address", "[i2cbus]")
+{
+	Rig rig;
+	for (int i = 0; i < 4; i++)
+		REQUIRE(rig.bus.units[i]->address == ADDRESSES[i]);
+	REQUIRE(rig.bus.collisions == 0);
+
+	//with every unit still on the default address, nothing can be read
+	FakeI2CBus shared;
+	shared.addUnit(1);
+	shared.addUnit(2);
+	std::unique_ptr<I2CDevice> atDefault = shared.open(LidarI2C::DEFAULT_ADDRESS);
+	REQUIRE_FALSE(LidarI2C::changeAddress(*atDefault, 0x64));
+	REQUIRE(shared.collisions == 1);
+}
+
+TEST_CASE("I2CBusScheduler overlaps acquisitions so every sensor keeps its rate", "[i2cbus]")
+{
+	Rig rig;
+	I2CBusScheduler scheduler;
+	for (const std::unique_ptr<LidarI2C> &lidar : rig.lidars)
+		scheduler.add(lidar.get(), 40);
+
+	const double SECONDS = 2;
+	rig.run(scheduler, SECONDS);
+
+	//one at a time, trigger and collect take at least a 20 ms acquisition each, 50 samples/s for the bus
+	double total = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		double rate = scheduler.getSamplesPerSecond(i, SECONDS);
+		total += rate;
+		INFO("sensor " << i << " " << rate << " samples/s");
+		REQUIRE(rate > 36);
+		REQUIRE(rig.lidars[i]->getDistance() == 100 * (i + 1));
+	}
+	INFO("four lidars sharing the bus at 40 Hz each: " << total << " samples/s");
+	REQUIRE(total > 3 * 50);
+}
+
+TEST_CASE("I2CBusScheduler gives a short bus to the higher priority sensor first", "[i2cbus]")
+{
+	Rig rig;
+	I2CBusScheduler scheduler(1); //100 samples/s for the whole bus
+	scheduler.add(rig.lidars[0].get(), 50);
+	scheduler.add(rig.lidars[1].get(), 50);
+	scheduler.add(rig.lidars[2].get(), 50, 1);
+	scheduler.add(rig.lidars[3].get(), 50);
+
+	const double SECONDS = 2;
+	rig.run(scheduler, SECONDS);
+
+	double high = scheduler.getSamplesPerSecond(2, SECONDS);
+	INFO("priority sensor " << high << " samples/s");
+	REQUIRE(high > 35);
+	for (int i : { 0, 1, 3 })
+	{
+		double low = scheduler.getSamplesPerSecond(i, SECONDS);
+		INFO("sensor " << i << " " << low << " samples/s");
+		REQUIRE(low < high);
+		REQUIRE(low > 10); //the rest still share what is left
+	}
+}
+
+TEST_CASE("I2CBusScheduler retries a sensor that NAKs and doesn't allocate", "[i2cbus]")
+{
+	Rig rig;
+	I2CBusScheduler scheduler;
+	for (const std::unique_ptr<LidarI2C> &lidar : rig.lidars)
+		scheduler.add(lidar.get(), 40);
+	rig.bus.units[1]->abortWrites = 3;
+
+	std::size_t before = allocationCount();
+	rig.run(scheduler, 1);
+	std::size_t allocations = allocationCount() - before;
+
+	REQUIRE(allocations == 0);
+	REQUIRE(scheduler.getAborted(1) == 3);
+	REQUIRE(scheduler.getSamplesPerSecond(1, 1) > 30);
+}
@@ -0,0 +1,114 @@
+#include <catch.hpp>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include "InlineFunction.hpp"
+#include "AllocationCounter.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+	struct Counter
+	{
+		int count;
+		Counter() : count(0) {}
+		void bump() { count++; }
+		int add(int amount) { count += amount; return count; }
+	};
+
+	int doubled(int value)
+	{
+		return value * 2;
+	}
+}
+
+TEST_CASE("InlineFunction stores a member function binding without allocating", "[inlinefunction]")
+{
+	Counter counter;
+	std::size_t before = allocationCount();
+	InlineFunction<void()> func(std::bind(&Counter::bump, &counter));
+	func();
+	func();
+	std::size_t after = allocationCount();
+
+	REQUIRE(after == before);
+	REQUIRE(counter.count == 2);
+}
+
+TEST_CASE("InlineFunction forwards arguments and return values", "[inlinefunction]")
+{
+	Counter counter;
+	InlineFunction<int(int)> add([&counter](int amount) { return counter.add(amount); });
+	InlineFunction<int(int)> twice(doubled);
+
+	REQUIRE(add(3) == 3);
+	REQUIRE(add(4) == 7);
+	REQUIRE(twice(21) == 42);
+}
+
+TEST_CASE("InlineFunction moves its callable and empties the source", "[inlinefunction]")
+{
+	Counter counter;
+	InlineFunction<void()> first([&counter]() { counter.bump(); });
+	InlineFunction<void()> second(std::move(first));
+	REQUIRE(!first);
+	REQUIRE(static_cast<bool>(second));
+	second();
+
+	InlineFunction<void()> third;
+	third = std::move(second);
+	REQUIRE(!second);
+	third();
+	REQUIRE(counter.count == 2);
+}
+
+TEST_CASE("InlineFunction destroys its callable exactly once", "[inlinefunction]")
+{
+	std::shared_ptr<int> shared(new int(0));
+	{
+		InlineFunction<void()> first([shared]() { (*shared)++; });
+		REQUIRE(shared.use_count() == 2);
+		InlineFunction<void()> second(std::move(first));
+		REQUIRE(shared.use_count() == 2);
+		second();
+		second.reset();
+		REQUIRE(shared.use_count() == 1);
+	}
+	REQUIRE(shared.use_count() == 1);
+	REQUIRE(*shared == 1);
+}
+
+TEST_CASE("InlineFunction against std::function", "[.][benchmark]")
+{
+	Counter counter;
+	const int CALLS = 2000000;
+	const int BUILDS = 200000;
+
+	double buildStd = nanosecondsPerIteration(BUILDS, [&](int)
+	{
+		std::function<void()> func(std::bind(&Counter::bump, &counter));
+		func();
+	});
+	double buildInline = nanosecondsPerIteration(BUILDS, [&](int)
+	{
+		InlineFunction<void()> func(std::bind(&Counter::bump, &counter));
+		func();
+	});
+
+	std::function<void()> stdFunc(std::bind(&Counter::bump, &counter));
+	InlineFunction<void()> inlineFunc(std::bind(&Counter::bump, &counter));
+	double callStd = nanosecondsPerIteration(CALLS, [&](int) { stdFunc(); });
+	double callInline = nanosecondsPerIteration(CALLS, [&](int) { inlineFunc(); });
+
+	std::size_t before = allocationCount();
+	std::function<void()> probe(std::bind(&Counter::bump, &counter));
+	std::size_t stdAllocations = allocationCount() - before;
+
+	reportBenchmark("std::function bind and call", buildStd);
+	reportBenchmark("InlineFunction bind and call", buildInline);
+	reportBenchmark("std::function call", callStd);
+	reportBenchmark("InlineFunction call", callInline);
+	std::cout << "std::function allocations per bind:\t" << stdAllocations << std::endl;
+	REQUIRE(counter.count == 2 * BUILDS + 2 * CALLS);
+}
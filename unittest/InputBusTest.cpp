@@ -0,0 +1,135 @@
+#include <catch.hpp>
+#include <functional>
+#include "InputBus.hpp"
+#include "AllocationCounter.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+	struct Counter
+	{
+		int count;
+		Counter() : count(0) {}
+		void bump() { count++; }
+	};
+
+	Action<void()> bump(Counter &counter)
+	{
+		return Action<void()>(std::bind(&Counter::bump, &counter), 0);
+	}
+}
+
+TEST_CASE("InputBus keeps subscribers on different devices apart", "[inputbus]")
+{
+	InputBus bus;
+	Counter driver, operatorPad;
+	bus.subscribe(0, Trigger, ButtonEdge::Down, bump(driver));
+	bus.subscribe(2, Trigger, ButtonEdge::Down, bump(operatorPad));
+
+	ButtonEdges driverEdges, operatorEdges;
+	operatorEdges.update(ButtonEdges::bit(Trigger));
+
+	bus.beginFrame();
+	bus.publish(0, driverEdges);
+	bus.publish(2, operatorEdges);
+	REQUIRE(bus.size() == 1);
+	REQUIRE(bus.dispatch(0) == 1);
+	REQUIRE(driver.count == 0);
+	REQUIRE(operatorPad.count == 1);
+}
+
+TEST_CASE("InputBus lists a frame's events in device then edge order", "[inputbus]")
+{
+	InputBus bus;
+	ButtonEdges first, second;
+	first.update(ButtonEdges::bit(3));
+	first.update(ButtonEdges::bit(3) | ButtonEdges::bit(5));
+	second.update(ButtonEdges::bit(1));
+	second.update(0);
+
+	bus.beginFrame();
+	bus.publish(0, first);
+	bus.publish(1, second);
+	REQUIRE(bus.size() == 3);
+
+	const InputEvent *event = bus.begin();
+	REQUIRE(event[0].device == 0);
+	REQUIRE(event[0].button == 5);
+	REQUIRE(event[0].edge == ButtonEdge::Down);
+	REQUIRE(event[1].button == 3);
+	REQUIRE(event[1].edge == ButtonEdge::Pressed);
+	REQUIRE(event[2].device == 1);
+	REQUIRE(event[2].button == 1);
+	REQUIRE(event[2].edge == ButtonEdge::Up);
+
+	bus.beginFrame();
+	REQUIRE(bus.size() == 0);
+}
+
+TEST_CASE("InputBus holds every button of every device without allocating", "[inputbus]")
+{
+	InputBus bus;
+	Counter counter;
+	for (int device = 0; device < InputBus::MAX_DEVICES; device++)
+		bus.subscribe(device, JoyButton(true, true, false, Button12), bump(counter));
+
+	ButtonEdges edges;
+	edges.update(~0u);
+
+	std::size_t before = allocationCount();
+	bus.beginFrame();
+	for (int device = 0; device < InputBus::MAX_DEVICES; device++)
+		bus.publish(device, edges);
+	bus.publish(InputBus::MAX_DEVICES, edges);
+	int ran = bus.dispatch(0);
+	std::size_t after = allocationCount();
+
+	REQUIRE(bus.size() == InputBus::MAX_EVENTS);
+	REQUIRE(ran == InputBus::MAX_DEVICES);
+	REQUIRE(after == before);
+}
+
+TEST_CASE("InputBus runs holds from each device's held buttons", "[inputbus]")
+{
+	InputBus bus;
+	Counter counter;
+	bus.subscribe(3, JoyButton::held(Button9, 0.3f), bump(counter));
+
+	ButtonEdges edges;
+	double now = 10;
+	for (int loop = 0; loop < 20; loop++, now += 0.02)
+	{
+		edges.update(ButtonEdges::bit(Button9));
+		bus.beginFrame();
+		bus.publish(3, edges);
+		bus.dispatch(now);
+		if (loop == 14)
+			REQUIRE(counter.count == 0); //0.28 s in
+	}
+	REQUIRE(counter.count == 1);
+}
+
+TEST_CASE("InputBus frame cost", "[.][benchmark]")
+{
+	const int FRAMES = 200000;
+	Counter counter;
+	InputBus bus;
+	for (int button = 1; button <= ActionMap::BUTTONS; button++)
+		bus.subscribe(0, button, ButtonEdge::Down, bump(counter));
+
+	std::array<ButtonEdges, InputBus::MAX_DEVICES> edges;
+	edges[0].update(ButtonEdges::bit(2) | ButtonEdges::bit(7));
+
+	for (int devices = 1; devices <= InputBus::MAX_DEVICES; devices++)
+	{
+		double ns = nanosecondsPerIteration(FRAMES, [&](int)
+		{
+			bus.beginFrame();
+			for (int device = 0; device < devices; device++)
+				bus.publish(device, edges[device]);
+			bus.dispatch(0);
+		});
+		reportBenchmark(std::to_string(devices) + " devices, 2 events", ns);
+	}
+	REQUIRE(counter.count == 2 * FRAMES * InputBus::MAX_DEVICES);
+}
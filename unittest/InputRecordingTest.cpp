@@ -0,0 +1,248 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include "InputRecording.hpp"
+#include "InputBus.hpp"
+#include "AxisFilter.hpp"
+#include "AllocationCounter.hpp"
+
+namespace
+{
+	const uint8_t STICKS = 0x3; //Extreme 3D on port 0, GameCube on port 1
+	const double PACKET_PERIOD = 0.02;
+	const int MATCH_FRAMES = 135 * 50;
+
+	//a driver working both sticks: long holds, sweeps on the drive axis, and button taps
+	InputFrame driverFrame(int i)
+	{
+		InputFrame frame;
+		frame.time = 3.5 + i * PACKET_PERIOD + (i % 3) * 0.0007;
+
+		InputSample &joystick = frame.devices[0];
+		float sweep = (i / 50) % 4 == 0 ? ((i % 50) - 25) / 25.f : 0;
+		joystick.axes[1] = InputSample::toRaw(sweep);
+		joystick.axes[2] = InputSample::toRaw((i / 200) % 2 == 0 ? 0.f : -0.4f);
+		if ((i / 37) % 5 == 0)
+			joystick.buttons |= 1u << 6;
+		if ((i / 90) % 7 == 3)
+			joystick.buttons |= 1u << 8;
+
+		InputSample &gamecube = frame.devices[1];
+		gamecube.axes[1] = InputSample::toRaw((i / 300) % 3 == 1 ? 0.9f : 0.f);
+		if (i % 61 < 4)
+			gamecube.buttons |= 1u << 3;
+		return frame;
+	}
+
+	//real sticks never sit still: every axis of every recorded port moves a count each frame
+	InputFrame noisyFrame(InputFrame frame, uint8_t ports, int i)
+	{
+		for (int port = 0; port < INPUT_DEVICES; port++)
+		{
+			if ((ports & (1 << port)) == 0)
+				continue;
+			for (int axis = 0; axis < INPUT_AXES; axis++)
+			{
+				int8_t &raw = frame.devices[port].axes[axis];
+				int jitter = (i + axis) % 2 == 0 ? 1 : -1;
+				raw = static_cast<int8_t>(std::max(-127, std::min(126, static_cast<int>(raw))) + jitter);
+			}
+		}
+		return frame;
+	}
+
+	struct Counter
+	{
+		int count;
+		Counter() : count(0) {}
+		void bump() { count++; }
+	};
+
+	//the hardware free half of EventRelay::checkStates(): edges onto the bus, drive axis through its filter
+	struct Session
+	{
+		InputBus bus;
+		std::array<ButtonEdges, INPUT_DEVICES> edges;
+		AxisFilter<ScaledDeadband, Expo, SlewLimiter> drive;
+		Counter counter;
+		double driveSum;
+
+		Session()
+			: drive(ScaledDeadband(0.1f), Expo(0.2f), SlewLimiter(0.25f))
+			, driveSum(0)
+		{
+			bus.subscribe(0, Button7, ButtonEdge::Down, Action<void()>(std::bind(&Counter::bump, &counter), 0));
+			bus.subscribe(0, JoyButton::held(Button9, 0.3f), Action<void()>(std::bind(&Counter::bump, &counter), 0));
+			bus.subscribe(1, BottomRight, ButtonEdge::Pressed, Action<void()>(std::bind(&Counter::bump, &counter), 0));
+		}
+
+		void step(const InputFrame &frame)
+		{
+			driveSum += drive(frame.devices[0].axis(1));
+			bus.beginFrame();
+			for (int port = 0; port < 2; port++)
+			{
+				edges[port].update(frame.devices[port].buttons);
+				bus.publish(port, edges[port]);
+			}
+			bus.dispatch(frame.time);
+		}
+	};
+}
+
+TEST_CASE("InputRecorder round trips frames through a file", "[inputrecording]")
+{
+	InputRecorder recorder(STICKS);
+	for (int i = 0; i < 500; i++)
+		recorder.record(driverFrame(i));
+
+	const char *file = "input_recording_test.inputs";
+	REQUIRE(recorder.write(file));
+
+	InputPlayer player;
+	REQUIRE(player.open(file));
+	REQUIRE(player.getDevices() == STICKS);
+
+	InputFrame frame;
+	int frames = 0;
+	bool matches = true;
+	while (player.next(frame))
+	{
+		InputFrame expected = driverFrame(frames);
+		double offset = expected.time - 3.5;
+		matches = matches && std::abs(frame.time - offset) < 1e-6;
+		for (int port = 0; port < 2; port++)
+		{
+			matches = matches && frame.devices[port].buttons == expected.devices[port].buttons
+							  && frame.devices[port].axes == expected.devices[port].axes;
+		}
+		frames++;
+	}
+	REQUIRE(frames == 500);
+	REQUIRE(matches);
+	REQUIRE(player.finished());
+	std::remove(file);
+}
+
+TEST_CASE("InputRecorder fits a match of jittering sticks in its reserved space without allocating", "[inputrecording]")
+{
+	InputRecorder recorder(STICKS);
+	std::size_t before = allocationCount();
+	bool recorded = true;
+	for (int i = 0; i < MATCH_FRAMES; i++)
+		recorded = recorder.record(noisyFrame(driverFrame(i), STICKS, i)) && recorded;
+	std::size_t after = allocationCount();
+
+	std::size_t size = recorder.data().size();
+	INFO("135 s of two jittering sticks: " << size << " bytes, " << static_cast<double>(size) / MATCH_FRAMES << " bytes per frame");
+	REQUIRE(after == before);
+	REQUIRE(recorded);
+	REQUIRE_FALSE(recorder.full());
+	REQUIRE(size < InputRecorder::RESERVED_BYTES);
+	REQUIRE(recorder.frames() == static_cast<std::size_t>(MATCH_FRAMES));
+}
+
+TEST_CASE("InputRecorder stops at its reserved space instead of growing", "[inputrecording]")
+{
+	const uint8_t ALL_PORTS = (1 << INPUT_DEVICES) - 1;
+	InputRecorder recorder(ALL_PORTS);
+	std::size_t capacity = recorder.data().capacity();
+	std::size_t before = allocationCount();
+	int i = 0;
+	while (recorder.record(noisyFrame(driverFrame(i), ALL_PORTS, i)))
+		i++;
+	std::size_t after = allocationCount();
+
+	REQUIRE(after == before);
+	REQUIRE(recorder.full());
+	REQUIRE(recorder.frames() == static_cast<std::size_t>(i));
+	REQUIRE(recorder.data().size() <= InputRecorder::RESERVED_BYTES);
+	REQUIRE(recorder.data().capacity() == capacity);
+	REQUIRE_FALSE(recorder.record(driverFrame(i)));
+
+	//everything that was recorded still plays back
+	InputPlayer player;
+	REQUIRE(player.load(recorder.data()));
+	InputFrame frame;
+	int frames = 0;
+	while (player.next(frame))
+		frames++;
+	REQUIRE(frames == i);
+
+	recorder.clear();
+	REQUIRE_FALSE(recorder.full());
+	REQUIRE(recorder.record(driverFrame(0)));
+}
+
+TEST_CASE("InputPlayer rejects bad streams and stops at truncation", "[inputrecording]")
+{
+	InputPlayer player;
+	REQUIRE_FALSE(player.load(std::vector<uint8_t>()));
+	REQUIRE_FALSE(player.load(std::vector<uint8_t>(32, 0)));
+	REQUIRE_FALSE(player.open("does_not_exist.inputs"));
+
+	InputRecorder recorder(STICKS);
+	for (int i = 0; i < 10; i++)
+		recorder.record(driverFrame(i));
+	std::vector<uint8_t> truncated(recorder.data().begin(), recorder.data().end() - 1);
+	REQUIRE(player.load(truncated));
+
+	InputFrame frame;
+	int frames = 0;
+	while (player.next(frame))
+		frames++;
+	REQUIRE(frames == 9);
+	REQUIRE(player.finished());
+}
+
+TEST_CASE("InputPlayer paces frames by their timestamps without skipping", "[inputrecording]")
+{
+	InputRecorder recorder(STICKS);
+	for (int i = 0; i < 5; i++)
+		recorder.record(driverFrame(i));
+	InputPlayer player;
+	REQUIRE(player.load(recorder.data()));
+
+	InputFrame frame;
+	REQUIRE(player.advance(0, frame));
+	REQUIRE_FALSE(player.advance(0.01, frame));
+	REQUIRE(player.advance(0.03, frame));
+	REQUIRE(frame.time == Approx(0.0207));
+	//running late still hands out every frame in order
+	REQUIRE(player.advance(1, frame));
+	REQUIRE(frame.time == Approx(0.0414));
+	REQUIRE(player.advance(1, frame));
+	REQUIRE(player.advance(1, frame));
+	REQUIRE_FALSE(player.advance(1, frame));
+	REQUIRE(player.finished());
+}
+
+TEST_CASE("A recorded match replays through the input pipeline in milliseconds", "[inputrecording]")
+{
+	Session live;
+	InputRecorder recorder(STICKS);
+	for (int i = 0; i < MATCH_FRAMES; i++)
+	{
+		InputFrame frame = driverFrame(i);
+		live.step(frame);
+		frame.time -= 3.5; //replayed times start at 0, keep the hold timers comparable
+		recorder.record(frame);
+	}
+
+	InputPlayer player;
+	REQUIRE(player.load(recorder.data()));
+	Session replayed;
+	InputFrame frame;
+	auto start = std::chrono::steady_clock::now();
+	while (player.next(frame))
+		replayed.step(frame);
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	INFO("replayed 135 s of teleop in " << ms << " ms");
+	REQUIRE(live.counter.count > 0);
+	REQUIRE(replayed.counter.count == live.counter.count);
+	REQUIRE(replayed.driveSum == live.driveSum);
+	REQUIRE(ms < 1000);
+}
@@ -0,0 +1,21 @@
+#include <catch.hpp>
+#include "InstanceCounter.hpp"
+
+class Counted : public InstanceCounter<Counted>
+{
+};
+
+TEST_CASE("InstanceCounter tracks live objects", "[instancecounter]") {
+	REQUIRE(Counted::live() == 0);
+	{
+		Counted a;
+		Counted b(a);
+		REQUIRE(Counted::live() == 2);
+
+		Counted *c = new Counted();
+		REQUIRE(Counted::live() == 3);
+		delete c;
+		REQUIRE(Counted::live() == 2);
+	}
+	REQUIRE(Counted::live() == 0);
+}
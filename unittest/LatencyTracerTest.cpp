@@ -0,0 +1,145 @@
+#include <catch.hpp>
+#include <array>
+#include <cmath>
+#include "LatencyTracer.hpp"
+#include "AllocationCounter.hpp"
+
+namespace
+{
+	const double PACKET_PERIOD = 0.02;
+
+	//drives the tracer the way TeleopPeriodic and EventRelay do: stamp the packet,
+	//tag stick moves, then issue the filtered command a little later in the loop
+	struct DriveLoop
+	{
+		LatencyTracer tracer;
+		std::array<double, 32> window; //moving average ring, length at most 32
+		std::size_t length;
+		std::size_t filled;
+		double lastInput;
+		double now;
+
+		DriveLoop(std::size_t filterLength)
+			: window()
+			, length(filterLength)
+			, filled(0)
+			, lastInput(0)
+			, now(0)
+		{
+		}
+
+		void packet(double stick, double processing)
+		{
+			tracer.packetArrived(now);
+			if (std::abs(stick - lastInput) > 0.05)
+				tracer.tag(LatencyPath::Drive, stick, 0.05);
+			lastInput = stick;
+
+			window[filled % length] = stick;
+			filled++;
+			std::size_t samples = filled < length ? filled : length;
+			double sum = 0;
+			for (std::size_t i = 0; i < samples; i++)
+				sum += window[i];
+			double command = sum / samples;
+			tracer.issued(LatencyPath::Drive, command, now + processing);
+			now += PACKET_PERIOD;
+		}
+
+		//full-stick steps, held long enough for the filter to catch up
+		void steps(int count)
+		{
+			for (int step = 0; step < count; step++)
+			{
+				double stick = step % 2 == 0 ? 1 : 0;
+				for (int i = 0; i < 40; i++)
+					packet(stick, 0.001 + 0.0001 * (i % 5));
+			}
+		}
+	};
+}
+
+TEST_CASE("LatencyHistogram buckets stay within 1/16 of the value", "[latency]")
+{
+	for (uint32_t value = 1; value < LatencyHistogram::MAX_VALUE; value = value * 3 / 2 + 1)
+	{
+		int bucket = LatencyHistogram::bucketFor(value);
+		REQUIRE(bucket < LatencyHistogram::BUCKETS);
+		REQUIRE(LatencyHistogram::lowestIn(bucket) <= value);
+		REQUIRE(LatencyHistogram::highestIn(bucket) >= value);
+		uint32_t scaledWidth = (LatencyHistogram::highestIn(bucket) - LatencyHistogram::lowestIn(bucket)) * 16;
+		REQUIRE(scaledWidth <= value);
+	}
+	REQUIRE(LatencyHistogram::bucketFor(LatencyHistogram::MAX_VALUE) == LatencyHistogram::BUCKETS - 1);
+}
+
+TEST_CASE("LatencyHistogram percentiles", "[latency]")
+{
+	LatencyHistogram histogram;
+	for (uint32_t value = 1; value <= 1000; value++)
+		histogram.record(value * 100);
+	histogram.record(50000000);
+
+	REQUIRE(histogram.count() == 1001);
+	REQUIRE(histogram.min() == 100);
+	REQUIRE(histogram.max() == LatencyHistogram::MAX_VALUE);
+
+	double median = histogram.percentile(50);
+	REQUIRE(median >= 50000);
+	REQUIRE(median <= 50000 * 17 / 16);
+	double tail = histogram.percentile(99);
+	REQUIRE(tail >= 99000);
+	REQUIRE(tail <= 99000 * 17 / 16);
+	REQUIRE(histogram.percentile(100) == LatencyHistogram::MAX_VALUE);
+}
+
+TEST_CASE("LatencyTracer times buttons from packet arrival to output", "[latency]")
+{
+	LatencyTracer tracer;
+	tracer.packetArrived(1.000);
+	tracer.tag(LatencyPath::Lifter);
+	REQUIRE(tracer.issued(LatencyPath::Lifter, 1.0025));
+	REQUIRE_FALSE(tracer.issued(LatencyPath::Lifter, 1.003)); //output without new input isn't timed
+
+	//a tag left unanswered keeps the older packet's stamp
+	tracer.packetArrived(1.020);
+	tracer.tag(LatencyPath::Shifter);
+	tracer.packetArrived(1.040);
+	tracer.tag(LatencyPath::Shifter);
+	tracer.issued(LatencyPath::Shifter, 1.041);
+
+	REQUIRE(tracer.getHistogram(LatencyPath::Lifter).count() == 1);
+	REQUIRE(tracer.getHistogram(LatencyPath::Lifter).max() == 2500);
+	REQUIRE(tracer.getHistogram(LatencyPath::Shifter).max() == 21000);
+	REQUIRE(tracer.getHistogram(LatencyPath::Drive).count() == 0);
+}
+
+TEST_CASE("LatencyTracer counts filter lag on the drive path", "[latency]")
+{
+	DriveLoop unfiltered(1);
+	DriveLoop legacy(25);
+	DriveLoop shortFilter(5);
+
+	std::size_t before = allocationCount();
+	unfiltered.tracer.reset();
+	unfiltered.steps(10);
+	std::size_t after = allocationCount();
+	REQUIRE(after == before);
+
+	legacy.steps(10);
+	shortFilter.steps(10);
+
+	const LatencyHistogram &none = unfiltered.tracer.getHistogram(LatencyPath::Drive);
+	const LatencyHistogram &slow = legacy.tracer.getHistogram(LatencyPath::Drive);
+	const LatencyHistogram &fast = shortFilter.tracer.getHistogram(LatencyPath::Drive);
+
+	REQUIRE(none.count() == 10);
+	REQUIRE(slow.count() == 10);
+	REQUIRE(none.percentile(99) < 1600);
+
+	//a 25 sample average is within 5% of a full step once 24 samples have it, 23 packets after the step
+	REQUIRE(slow.percentile(50) >= 460000);
+	REQUIRE(slow.percentile(50) < 480000);
+	REQUIRE(fast.percentile(50) >= 80000);
+	REQUIRE(fast.percentile(50) < 90000);
+}
@@ -0,0 +1,117 @@
+#include <catch.hpp>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include "LidarI2C.hpp"
+#include "FakeLidarLite.hpp"
+#include "AllocationCounter.hpp"
+
+namespace
+{
+	//the driver owns its device, the test keeps a pointer to steer it
+	struct Rig
+	{
+		FakeLidarLite *fake;
+		LidarI2C lidar;
+
+		Rig()
+			: fake(new FakeLidarLite())
+			, lidar(std::unique_ptr<I2CDevice>(fake))
+		{
+		}
+
+		void update(double now)
+		{
+			fake->now = now;
+			lidar.update(now);
+		}
+	};
+}
+
+TEST_CASE("LidarI2C triggers in one call and collects in a later one", "[lidari2c]")
+{
+	Rig rig;
+	rig.fake->centimeters = 312;
+	REQUIRE(rig.lidar.getDistance() == 0);
+	REQUIRE(std::isinf(rig.lidar.getAge(0)));
+
+	rig.update(1.00);
+	REQUIRE(rig.fake->writes == 1);
+	REQUIRE(rig.fake->reads == 0);
+
+	rig.update(1.01); //too early to collect, nothing goes on the bus
+	REQUIRE(rig.fake->writes == 1);
+	REQUIRE(rig.fake->reads == 0);
+
+	rig.fake->centimeters = 400; //the next measurement
+	rig.update(1.025);
+	REQUIRE(rig.fake->reads == 1);
+	REQUIRE(rig.fake->writes == 2);
+	REQUIRE(rig.lidar.getDistance() == 312);
+	double age = rig.lidar.getAge(1.055);
+	REQUIRE(std::abs(age - 0.03) < 1e-6);
+
+	rig.update(1.05);
+	REQUIRE(rig.lidar.getDistance() == 400);
+	REQUIRE(rig.fake->abortedReads == 0);
+}
+
+TEST_CASE("LidarI2C retries a busy sensor and restarts a measurement that never finishes", "[lidari2c]")
+{
+	Rig rig;
+	rig.fake->centimeters = 150;
+	rig.fake->measureSeconds = 0.045; //slower than the driver expects
+
+	rig.update(0);
+	rig.update(0.02); //NAKed
+	rig.update(0.04); //NAKed
+	rig.update(0.06);
+	REQUIRE(rig.fake->abortedReads == 2);
+	REQUIRE(rig.lidar.getDistance() == 150);
+
+	rig.fake->measureSeconds = 10; //stuck
+	double now = 0.06;
+	for (int i = 0; i < LidarI2C::READ_TRIES; i++)
+	{
+		now += 0.02;
+		rig.update(now);
+	}
+	int writes = rig.fake->writes;
+	REQUIRE(writes == 3); //first trigger, after the good read, and after giving up
+	REQUIRE(rig.lidar.getDistance() == 150);
+	double age = rig.lidar.getAge(now);
+	REQUIRE(std::abs(age - 0.1) < 1e-6);
+}
+
+TEST_CASE("LidarI2C retries an aborted trigger on the next call", "[lidari2c]")
+{
+	Rig rig;
+	rig.fake->centimeters = 90;
+	rig.fake->abortWrites = 2;
+
+	rig.update(0);
+	rig.update(0.03);
+	REQUIRE(rig.fake->reads == 0);
+	rig.update(0.06); //acknowledged
+	rig.update(0.09);
+	REQUIRE(rig.fake->writes == 4);
+	REQUIRE(rig.lidar.getDistance() == 90);
+}
+
+TEST_CASE("LidarI2C never waits or allocates in update", "[lidari2c]")
+{
+	Rig rig;
+	rig.fake->centimeters = 200;
+	rig.fake->measureSeconds = 0.035; //every other collect is NAKed
+
+	std::size_t before = allocationCount();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < 1000; i++)
+		rig.update(i * 0.02);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::size_t allocations = allocationCount() - before;
+
+	REQUIRE(allocations == 0);
+	REQUIRE(seconds < 0.01); //the old driver waited at least 7 ms per read
+	REQUIRE(rig.lidar.getDistance() == 200);
+}
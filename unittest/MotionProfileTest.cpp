@@ -0,0 +1,162 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include "MotionProfile.hpp"
+#include "ProfileFollower.hpp"
+#include "DriveConstants.hpp"
+
+using namespace DriveConstants;
+
+namespace
+{
+	//one side of the drivetrain: output drives speed toward output * MAX_VELOCITY
+	struct SimulatedSide
+	{
+		float position;
+		float velocity;
+
+		SimulatedSide() : position(0), velocity(0) {}
+
+		void step(float output, float dt)
+		{
+			velocity += (output * MAX_VELOCITY - velocity) / MOTOR_TIME_CONSTANT * dt;
+			position += velocity * dt;
+		}
+	};
+
+	struct MoveResult
+	{
+		float timeToRest; //time until the robot is stopped and the move is over
+		float finalPosition;
+		float overshoot;
+	};
+
+	const float SIM_DT = 0.001f;
+	const float LOOP_PERIOD = 0.02f;
+
+	//old DriveAuto::Move: constant output, cut to zero once past the distance
+	MoveResult constantVelocityMove(float inches, float motorVelocity)
+	{
+		SimulatedSide side;
+		float output = motorVelocity;
+		float t = 0, nextLoop = 0;
+		float peak = 0;
+		bool cut = false;
+		while (t < 10)
+		{
+			if (t >= nextLoop)
+			{
+				if (side.position > inches)
+				{
+					output = 0;
+					cut = true;
+				}
+				nextLoop += LOOP_PERIOD;
+			}
+			side.step(output, SIM_DT);
+			t += SIM_DT;
+			peak = std::max(peak, side.position);
+			if (cut && std::abs(side.velocity) < 1.f)
+				break;
+		}
+		MoveResult result = { t, side.position, peak - inches };
+		return result;
+	}
+
+	MoveResult profiledMove(float inches, float jerk)
+	{
+		MotionProfile profile;
+		REQUIRE(profile.generate(inches, MAX_VELOCITY, MAX_ACCELERATION, jerk, PROFILE_PERIOD));
+
+		ProfileFollower follower(MOVE_KV, MOVE_KA, MOVE_KP, MOVE_KD, MOVE_TOLERANCE, MOVE_TIMEOUT);
+		follower.start(&profile);
+
+		SimulatedSide side;
+		float output = 0;
+		float t = 0, nextLoop = 0;
+		float peak = 0;
+		bool done = false;
+		while (t < 10)
+		{
+			if (t >= nextLoop)
+			{
+				if (follower.isFinished(t, side.position))
+				{
+					output = 0;
+					done = true;
+				}
+				else
+				{
+					output = follower.calculate(t, side.position);
+				}
+				nextLoop += LOOP_PERIOD;
+			}
+			side.step(output, SIM_DT);
+			t += SIM_DT;
+			peak = std::max(peak, side.position);
+			if (done && std::abs(side.velocity) < 1.f)
+				break;
+		}
+		MoveResult result = { t, side.position, peak - inches };
+		return result;
+	}
+}
+
+TEST_CASE("MotionProfile reaches the requested distance at rest", "[motionprofile]") {
+	MotionProfile profile;
+	REQUIRE(profile.generate(72, MAX_VELOCITY, MAX_ACCELERATION, 0, PROFILE_PERIOD));
+
+	const ProfileSample &last = profile.getSample(profile.size() - 1);
+	REQUIRE(std::abs(last.position - 72) < 1e-3);
+	REQUIRE(last.velocity == 0);
+	REQUIRE(profile.getSample(0).velocity == 0);
+
+	for (int i = 0; i < profile.size(); i++)
+	{
+		REQUIRE(profile.getSample(i).velocity <= MAX_VELOCITY + 1e-3);
+		REQUIRE(std::abs(profile.getSample(i).acceleration) <= MAX_ACCELERATION * 1.05f);
+	}
+}
+
+TEST_CASE("MotionProfile cruises on long moves and handles reverse", "[motionprofile]") {
+	MotionProfile profile;
+	REQUIRE(profile.generate(-300, 100, MAX_ACCELERATION, 0, PROFILE_PERIOD));
+
+	REQUIRE(std::abs(profile.getSample(profile.size() - 1).position + 300) < 1e-2);
+	REQUIRE(std::abs(profile.sampleAt(profile.getDuration() / 2).velocity + 100) < 0.5f);
+}
+
+TEST_CASE("S-curve profile limits the change in acceleration", "[motionprofile]") {
+	MotionProfile trapezoid, sCurve;
+	REQUIRE(trapezoid.generate(72, MAX_VELOCITY, MAX_ACCELERATION, 0, PROFILE_PERIOD));
+	REQUIRE(sCurve.generate(72, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD));
+
+	float maxJerk = 0;
+	for (int i = 1; i < sCurve.size() - 1; i++)
+	{
+		float jerk = (sCurve.getSample(i).acceleration - sCurve.getSample(i - 1).acceleration) / PROFILE_PERIOD;
+		maxJerk = std::max(maxJerk, std::abs(jerk));
+	}
+
+	REQUIRE(maxJerk <= MAX_JERK * 1.1f);
+	REQUIRE(sCurve.getDuration() > trapezoid.getDuration());
+	REQUIRE(std::abs(sCurve.getSample(sCurve.size() - 1).position - 72) < 1e-3);
+}
+
+TEST_CASE("MotionProfile rejects moves longer than its table", "[motionprofile]") {
+	MotionProfile profile;
+	REQUIRE_FALSE(profile.generate(100000, 10, MAX_ACCELERATION, 0, PROFILE_PERIOD));
+	REQUIRE(profile.size() == 1);
+}
+
+TEST_CASE("Profiled 72 inch move beats the constant velocity move in simulation", "[motionprofile][simulation]") {
+	MoveResult old = constantVelocityMove(72, 0.5f);
+	MoveResult profiled = profiledMove(72, MAX_JERK);
+
+	INFO("72in constant 0.5 output: rest after " << old.timeToRest << " s, overshoot " << old.overshoot << " in");
+	INFO("72in S-curve profile:     rest after " << profiled.timeToRest << " s, overshoot " << profiled.overshoot << " in");
+
+	REQUIRE(profiled.timeToRest < old.timeToRest);
+	REQUIRE(profiled.overshoot < MOVE_TOLERANCE);
+	REQUIRE(std::abs(profiled.finalPosition - 72) < MOVE_TOLERANCE);
+}
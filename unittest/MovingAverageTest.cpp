@@ -0,0 +1,234 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <list>
+#include <random>
+#include <vector>
+#include "MovingAverage.hpp"
+#include "TrimmedMean.hpp"
+#include "Benchmark.hpp"
+#include "AllocationCounter.hpp"
+
+namespace
+{
+	//the list based average DriveAuto's ToteAlign code used: copy the window, drop the extremes, re-sum
+	struct ListTrimmedMean
+	{
+		std::list<double> window;
+		std::size_t length;
+
+		explicit ListTrimmedMean(std::size_t length)
+			: length(length)
+		{
+		}
+
+		double operator()(double value)
+		{
+			window.push_front(value);
+			if (window.size() > length)
+				window.pop_back();
+
+			double min = *std::min_element(window.begin(), window.end());
+			double max = *std::max_element(window.begin(), window.end());
+			std::list<double> copy = window;
+			copy.remove_if([&](double e) { return e <= min || e >= max; });
+
+			double sum = 0;
+			for (double e : copy)
+				sum += e;
+			return copy.empty() ? 0 : sum / copy.size();
+		}
+	};
+
+	//plain average over a std::list, summed on every sample
+	struct ListAverage
+	{
+		std::list<double> window;
+		std::size_t length;
+
+		explicit ListAverage(std::size_t length)
+			: length(length)
+		{
+		}
+
+		double operator()(double value)
+		{
+			window.push_front(value);
+			if (window.size() > length)
+				window.pop_back();
+
+			double sum = 0;
+			for (double e : window)
+				sum += e;
+			return sum / window.size();
+		}
+	};
+
+	//sorts the last length values and averages what is left after trimming
+	double bruteTrimmedMean(const std::vector<double> &history, std::size_t length, std::size_t trim)
+	{
+		std::size_t count = std::min(history.size(), length);
+		std::vector<double> window(history.end() - count, history.end());
+		std::sort(window.begin(), window.end());
+		trim = std::min(trim, (count - 1) / 2);
+
+		double sum = 0;
+		for (std::size_t i = trim; i < count - trim; i++)
+			sum += window[i];
+		return sum / (count - 2 * trim);
+	}
+}
+
+TEST_CASE("MovingAverage averages what it has until the window fills", "[movingaverage]")
+{
+	MovingAverage<double> average(4);
+	REQUIRE(average.computeAverage() == 0);
+
+	average.giveRawValue(2);
+	REQUIRE(average.computeAverage() == 2);
+	average.giveRawValue(4);
+	REQUIRE(average.computeAverage() == 3);
+	average.giveRawValue(6);
+	average.giveRawValue(8);
+	REQUIRE(average.computeAverage() == 5);
+
+	average.giveRawValue(10); //the 2 falls out
+	REQUIRE(average.computeAverage() == 7);
+	REQUIRE(average.size() == 4);
+
+	average.reset();
+	REQUIRE(average.size() == 0);
+	average.giveRawValue(1);
+	REQUIRE(average.computeAverage() == 1);
+}
+
+TEST_CASE("MovingAverage doesn't drift over a long run", "[movingaverage]")
+{
+	MovingAverage<double> average(12);
+	std::vector<double> history;
+	std::mt19937 random(20);
+	std::uniform_real_distribution<double> distance(0, 1000);
+
+	for (int i = 0; i < 100000; i++)
+	{
+		double value = distance(random);
+		history.push_back(value);
+		average.giveRawValue(value);
+	}
+
+	double expected = bruteTrimmedMean(history, 12, 0);
+	double error = std::abs(average.computeAverage() - expected);
+	REQUIRE(error < 1e-9);
+}
+
+TEST_CASE("TrimmedMean matches sorting the window", "[movingaverage]")
+{
+	const std::size_t LENGTH = 12;
+	const std::size_t TRIMS[] = { 0, 1, 3, 5 };
+	std::mt19937 random(42);
+	std::uniform_int_distribution<int> distance(0, 40); //small range so there are plenty of ties
+
+	for (std::size_t trim : TRIMS)
+	{
+		TrimmedMean<double> filter(LENGTH, trim);
+		std::vector<double> history;
+		bool matches = true;
+		for (int i = 0; i < 2000; i++)
+		{
+			double value = distance(random);
+			history.push_back(value);
+			filter.giveRawValue(value);
+			if (std::abs(filter.computeAverage() - bruteTrimmedMean(history, LENGTH, trim)) > 1e-9)
+				matches = false;
+		}
+		INFO("trim " << trim);
+		REQUIRE(matches);
+	}
+}
+
+TEST_CASE("MovingMedian drops spikes a moving average follows", "[movingaverage]")
+{
+	MovingMedian<double> median(5);
+	MovingAverage<double> average(5);
+	const double READINGS[] = { 80, 81, 400, 80, 79, 0, 81 }; //a reflection and a dropout
+
+	for (double reading : READINGS)
+	{
+		median.giveRawValue(reading);
+		average.giveRawValue(reading);
+	}
+	REQUIRE(median.computeAverage() == 80);
+	REQUIRE(average.computeAverage() == 128);
+
+	MovingMedian<double> even(4);
+	even.giveRawValue(1);
+	even.giveRawValue(2);
+	even.giveRawValue(10);
+	even.giveRawValue(3);
+	REQUIRE(even.computeAverage() == 2.5);
+}
+
+TEST_CASE("MovingAverage and TrimmedMean don't allocate per sample", "[movingaverage]")
+{
+	MovingAverage<double> average(12);
+	TrimmedMean<double> trimmed(12, 1);
+	MovingMedian<double> median(25);
+
+	std::size_t before = allocationCount();
+	for (int i = 0; i < 1000; i++)
+	{
+		double value = (i * 37) % 101;
+		average.giveRawValue(value);
+		trimmed.giveRawValue(value);
+		median.giveRawValue(value);
+	}
+	trimmed.reset();
+	trimmed.giveRawValue(1);
+	std::size_t allocations = allocationCount() - before;
+	REQUIRE(allocations == 0);
+}
+
+TEST_CASE("MovingAverage and TrimmedMean against std::list", "[.][benchmark]")
+{
+	const int SAMPLES = 200000;
+	const std::size_t LENGTH = 12;
+	std::vector<double> readings(1024);
+	std::mt19937 random(7);
+	std::normal_distribution<double> noise(80, 3);
+	for (double &reading : readings)
+		reading = noise(random);
+
+	double sink = 0;
+	ListAverage listAverage(LENGTH);
+	double listAverageNs = nanosecondsPerIteration(SAMPLES, [&](int i) { sink += listAverage(readings[i & 1023]); });
+	MovingAverage<double> average(LENGTH);
+	double averageNs = nanosecondsPerIteration(SAMPLES, [&](int i)
+	{
+		average.giveRawValue(readings[i & 1023]);
+		sink += average.computeAverage();
+	});
+
+	ListTrimmedMean listTrimmed(LENGTH);
+	double listTrimmedNs = nanosecondsPerIteration(SAMPLES, [&](int i) { sink += listTrimmed(readings[i & 1023]); });
+	TrimmedMean<double> trimmed(LENGTH, 1);
+	double trimmedNs = nanosecondsPerIteration(SAMPLES, [&](int i)
+	{
+		trimmed.giveRawValue(readings[i & 1023]);
+		sink += trimmed.computeAverage();
+	});
+
+	MovingMedian<double> median(101);
+	double medianNs = nanosecondsPerIteration(SAMPLES, [&](int i)
+	{
+		median.giveRawValue(readings[i & 1023]);
+		sink += median.computeAverage();
+	});
+
+	reportBenchmark("std::list average, 12 samples", listAverageNs);
+	reportBenchmark("MovingAverage, 12 samples", averageNs);
+	reportBenchmark("std::list trimmed mean, 12 samples", listTrimmedNs);
+	reportBenchmark("TrimmedMean, 12 samples", trimmedNs);
+	reportBenchmark("MovingMedian, 101 samples", medianNs);
+	REQUIRE(sink > 0);
+}
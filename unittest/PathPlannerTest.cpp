@@ -0,0 +1,126 @@
+#include <catch.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "PathPlanner.hpp"
+#include "TrajectoryCache.hpp"
+#include "AutoPaths.hpp"
+#include "DriveConstants.hpp"
+
+using namespace DriveConstants;
+
+namespace
+{
+	PathPlanner planner()
+	{
+		return PathPlanner(TRACK_WIDTH, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD);
+	}
+
+	std::vector<Waypoint> path(Waypoint a, Waypoint b)
+	{
+		std::vector<Waypoint> waypoints;
+		waypoints.push_back(a);
+		waypoints.push_back(b);
+		return waypoints;
+	}
+}
+
+TEST_CASE("Straight path drives both wheels the same distance", "[pathplanner]") {
+	Trajectory trajectory;
+	Waypoint a = { 0, 0, 0 }, b = { 72, 0, 0 };
+	REQUIRE(planner().plan(path(a, b), trajectory));
+
+	REQUIRE(std::abs(trajectory.left.back().position - 72) < 0.1f);
+	REQUIRE(std::abs(trajectory.right.back().position - 72) < 0.1f);
+	REQUIRE(std::abs(trajectory.heading.back()) < 0.1f);
+	REQUIRE(trajectory.left.back().velocity == 0);
+}
+
+TEST_CASE("Curved path turns the robot through the waypoint headings", "[pathplanner]") {
+	Trajectory trajectory;
+	Waypoint a = { 0, 0, 0 }, b = { 60, 60, 90 };
+	REQUIRE(planner().plan(path(a, b), trajectory));
+
+	//a left turn means the right wheel travels farther by trackWidth * angle
+	float difference = trajectory.right.back().position - trajectory.left.back().position;
+	REQUIRE(std::abs(difference - TRACK_WIDTH * 3.14159265f / 2) < 1.f);
+	REQUIRE(std::abs(trajectory.heading.back() - 90) < 1.f);
+
+	for (std::size_t i = 0; i < trajectory.left.size(); i++)
+	{
+		REQUIRE(trajectory.left[i].velocity <= MAX_VELOCITY + 0.1f);
+		REQUIRE(trajectory.right[i].velocity <= MAX_VELOCITY + 0.1f);
+	}
+}
+
+TEST_CASE("Planner needs at least two waypoints", "[pathplanner]") {
+	Trajectory trajectory;
+	std::vector<Waypoint> waypoints;
+	REQUIRE_FALSE(planner().plan(waypoints, trajectory));
+}
+
+TEST_CASE("TrajectoryCache round trips through a memory mapped file", "[trajectorycache]") {
+	const char *file = "trajectory_cache_test.bin";
+	std::vector<Trajectory> trajectories(2);
+	Waypoint a = { 0, 0, 0 }, b = { 72, 0, 0 }, c = { 80, -40, -60 };
+	REQUIRE(planner().plan(path(a, b), trajectories[0]));
+	REQUIRE(planner().plan(path(a, c), trajectories[1]));
+	trajectories[0].name = "Straight";
+	trajectories[1].name = "Curve";
+	REQUIRE(TrajectoryCache::write(file, trajectories));
+
+	TrajectoryCache cache;
+	auto start = std::chrono::steady_clock::now();
+	REQUIRE(cache.open(file));
+	const TrajectoryView *curve = cache.find("Curve");
+	auto stop = std::chrono::steady_clock::now();
+	double micros = std::chrono::duration<double, std::micro>(stop - start).count();
+	INFO("open and find a cached trajectory: " << micros << " us");
+
+	REQUIRE(cache.size() == 2);
+	REQUIRE(curve != nullptr);
+	REQUIRE(cache.find("Missing") == nullptr);
+	REQUIRE(curve->count == static_cast<int>(trajectories[1].left.size()));
+	REQUIRE(curve->period == trajectories[1].period);
+	for (int i = 0; i < curve->count; i++)
+	{
+		REQUIRE(curve->left[i].position == trajectories[1].left[i].position);
+		REQUIRE(curve->right[i].velocity == trajectories[1].right[i].velocity);
+		REQUIRE(curve->heading[i] == trajectories[1].heading[i]);
+	}
+
+	cache.close();
+	std::remove(file);
+}
+
+TEST_CASE("TrajectoryCache keeps the hash of what it was planned from", "[trajectorycache]") {
+	const char *file = "trajectory_cache_hash.bin";
+	REQUIRE(TrajectoryCache::write(file, AutoPaths::build(), AutoPaths::sourceHash()));
+
+	TrajectoryCache cache;
+	REQUIRE(cache.open(file));
+	REQUIRE(cache.getSourceHash() == AutoPaths::sourceHash());
+	REQUIRE(AutoPaths::sourceHash() == AutoPaths::sourceHash());
+
+	//a file planned from other paths reads back with its own hash, which is what makes RobotInit replan
+	REQUIRE(TrajectoryCache::write(file, AutoPaths::build(), AutoPaths::sourceHash() + 1));
+	REQUIRE(cache.open(file));
+	REQUIRE(cache.getSourceHash() != AutoPaths::sourceHash());
+
+	cache.close();
+	REQUIRE(cache.getSourceHash() == 0);
+	std::remove(file);
+}
+
+TEST_CASE("TrajectoryCache rejects files that are not caches", "[trajectorycache]") {
+	const char *file = "trajectory_cache_bad.bin";
+	std::FILE *out = std::fopen(file, "wb");
+	std::fputs("not a trajectory cache", out);
+	std::fclose(out);
+
+	TrajectoryCache cache;
+	REQUIRE_FALSE(cache.open(file));
+	REQUIRE_FALSE(cache.isOpen());
+	REQUIRE_FALSE(cache.open("does_not_exist.bin"));
+	std::remove(file);
+}
@@ -0,0 +1,202 @@
+#include <catch.hpp>
+#include <cmath>
+#include <vector>
+#include "PurePursuit.hpp"
+#include "PathPlanner.hpp"
+#include "AutoPaths.hpp"
+#include "Odometry.hpp"
+#include "DriveConstants.hpp"
+#include "MotionProfile.hpp"
+#include "HeadingController.hpp"
+#include "ProfileFollower.hpp"
+#include "Benchmark.hpp"
+#include "SimulatedDrive.hpp"
+
+using namespace DriveConstants;
+
+namespace
+{
+	const float SIM_DT = 0.001f;
+	const float LOOP_PERIOD = 0.01f;
+	const float PI = 3.14159265f;
+
+	PurePursuit follower()
+	{
+		return PurePursuit(PURSUIT_LOOKAHEAD, TRACK_WIDTH, PURSUIT_MAX_VELOCITY, PURSUIT_MAX_ACCELERATION, PURSUIT_TOLERANCE);
+	}
+
+	std::vector<PursuitPoint> plan(const std::vector<Waypoint> &waypoints)
+	{
+		PathPlanner planner(TRACK_WIDTH, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD);
+		std::vector<PursuitPoint> points;
+		planner.planPoints(waypoints, PURSUIT_SPACING, points);
+		return points;
+	}
+
+	struct PursuitResult
+	{
+		float seconds;
+		float maxCrossTrack;
+		int maxSearch;
+		Pose end;
+	};
+
+	//drives the path with odometry fed from the simulated encoders and heading
+	PursuitResult pursue(const std::vector<PursuitPoint> &points)
+	{
+		PursuitPath path = { points.data(), static_cast<int>(points.size()) };
+		PurePursuit pursuit = follower();
+		pursuit.start(&path);
+		SimulatedDrive robot;
+		Odometry odometry;
+		odometry.reset(0, 0, 0);
+
+		PursuitResult result = { 0, 0, 0, robot.pose };
+		WheelSpeeds speeds = { 0, 0 };
+		float t = 0, nextLoop = 0;
+		while (!pursuit.isFinished() && t < 20)
+		{
+			if (t >= nextLoop)
+			{
+				odometry.update(robot.leftDistance, robot.rightDistance, robot.pose.heading);
+				speeds = pursuit.calculate(odometry.getPose(), LOOP_PERIOD);
+				result.maxSearch = std::max(result.maxSearch, pursuit.getLastSearchCount());
+
+				const PursuitPoint &closest = points[pursuit.getClosestIndex()];
+				float offTrack = std::hypot(closest.x - robot.pose.x, closest.y - robot.pose.y);
+				result.maxCrossTrack = std::max(result.maxCrossTrack, offTrack);
+				nextLoop += LOOP_PERIOD;
+			}
+			robot.step(speeds.left * MOVE_KV, speeds.right * MOVE_KV, SIM_DT);
+			t += SIM_DT;
+		}
+		result.seconds = t;
+		result.end = robot.pose;
+		return result;
+	}
+
+	//the same ground covered as stop-and-go Move, Turn, Move actions
+	float stopAndGoSeconds(float firstLeg, float degrees, float secondLeg)
+	{
+		MotionProfile profile;
+		float seconds = 0;
+		profile.generate(firstLeg, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD);
+		seconds += profile.getDuration();
+		profile.generate(secondLeg, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD);
+		seconds += profile.getDuration();
+
+		//the turn's profiled setpoint alone, before settling
+		float rampTime = TURN_MAX_RATE / TURN_MAX_ACCELERATION;
+		float rampDegrees = TURN_MAX_RATE * rampTime;
+		float turn = std::abs(degrees);
+		seconds += turn > rampDegrees ? 2 * rampTime + (turn - rampDegrees) / TURN_MAX_RATE
+		                              : 2 * std::sqrt(turn / TURN_MAX_ACCELERATION);
+		return seconds;
+	}
+}
+
+TEST_CASE("Odometry integrates arcs from encoders and heading", "[PurePursuit]")
+{
+	Odometry odometry;
+	odometry.reset(10, 20, 30);
+
+	//quarter circle to the left with a 50 inch radius
+	const int STEPS = 100;
+	for (int i = 1; i <= STEPS; i++)
+	{
+		float arc = 50 * PI / 2 * i / STEPS;
+		odometry.update(10 + arc, 20 + arc, 30 + 90.f * i / STEPS);
+	}
+
+	REQUIRE(odometry.getPose().x == Approx(50).epsilon(0.01));
+	REQUIRE(odometry.getPose().y == Approx(50).epsilon(0.01));
+	REQUIRE(odometry.getPose().heading == Approx(90));
+}
+
+TEST_CASE("relativePose moves a pose into another pose's frame", "[PurePursuit]")
+{
+	Pose origin = { 10, 10, 90 };
+	Pose ahead = { 10, 30, 90 };
+	Pose relative = relativePose(ahead, origin);
+	REQUIRE(relative.x == Approx(20));
+	REQUIRE(std::abs(relative.y) < 0.001f);
+	REQUIRE(relative.heading == Approx(0));
+}
+
+TEST_CASE("PathPlanner spaces pursuit points evenly along the spline", "[PurePursuit]")
+{
+	Waypoint start = { 0, 0, 0 }, end = { 100, 0, 0 };
+	std::vector<PursuitPoint> points = plan({ start, end });
+
+	REQUIRE(points.size() == 51);
+	for (std::size_t i = 1; i < points.size(); i++)
+		REQUIRE(std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y) <= PURSUIT_SPACING + 0.01f);
+	REQUIRE(points.back().x == Approx(100));
+}
+
+TEST_CASE("PurePursuit drives a curve without stopping and ends on the path", "[PurePursuit]")
+{
+	std::vector<PursuitPoint> points = plan(AutoPaths::waypoints("SweepRight"));
+	REQUIRE_FALSE(points.empty());
+	PursuitResult result = pursue(points);
+
+	INFO("sweep: pure pursuit " << result.seconds << " s, max cross track " << result.maxCrossTrack
+	     << " in, stop-and-go about " << stopAndGoSeconds(67, -63.4f, 67) << " s");
+
+	REQUIRE(result.seconds < 4);
+	REQUIRE(std::hypot(result.end.x - 120, result.end.y + 60) < 3);
+	REQUIRE(result.maxCrossTrack < 6);
+	REQUIRE(result.seconds < stopAndGoSeconds(67, -63.4f, 67));
+}
+
+TEST_CASE("PurePursuit examines a bounded number of points per cycle", "[PurePursuit]")
+{
+	//long path with fine spacing, a full scan would look at thousands of points
+	Waypoint start = { 0, 0, 0 }, middle = { 200, 100, 45 }, end = { 400, 200, 0 };
+	PathPlanner planner(TRACK_WIDTH, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD);
+	std::vector<PursuitPoint> points;
+	planner.planPoints({ start, middle, end }, 0.25f, points);
+	REQUIRE(points.size() > 1000);
+
+	PursuitResult result = pursue(points);
+	REQUIRE(result.maxSearch <= 2 * PurePursuit::SEARCH_WINDOW);
+	REQUIRE(std::hypot(result.end.x - 400, result.end.y - 200) < 3);
+}
+
+TEST_CASE("PurePursuit reports finished for a path too short to follow", "[PurePursuit]")
+{
+	PursuitPoint only = { 0, 0 };
+	PursuitPath path = { &only, 1 };
+	PurePursuit pursuit = follower();
+	pursuit.start(&path);
+	REQUIRE(pursuit.isFinished());
+
+	Pose pose = { 0, 0, 0 };
+	WheelSpeeds speeds = pursuit.calculate(pose, LOOP_PERIOD);
+	REQUIRE(speeds.left == 0);
+	REQUIRE(speeds.right == 0);
+}
+
+TEST_CASE("PurePursuit cycle cost", "[.][benchmark]")
+{
+	Waypoint start = { 0, 0, 0 }, middle = { 200, 100, 45 }, end = { 400, 200, 0 };
+	PathPlanner planner(TRACK_WIDTH, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK, PROFILE_PERIOD);
+	std::vector<PursuitPoint> points;
+	planner.planPoints({ start, middle, end }, 0.25f, points);
+	PursuitPath path = { points.data(), static_cast<int>(points.size()) };
+
+	PurePursuit pursuit = follower();
+	pursuit.start(&path);
+	float sink = 0;
+	double ns = nanosecondsPerIteration(100000, [&](int i)
+	{
+		//walk the pose slowly along the path so the search keeps moving
+		const PursuitPoint &near = points[(i / 100) % points.size()];
+		Pose pose = { near.x, near.y + 1, 0 };
+		if (i % 100 == 0 && (i / 100) % points.size() == 0)
+			pursuit.start(&path);
+		sink += pursuit.calculate(pose, LOOP_PERIOD).left;
+	});
+	reportBenchmark("PurePursuit::calculate, 3000 point path", ns);
+	REQUIRE(sink == sink);
+}
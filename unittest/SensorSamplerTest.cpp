@@ -0,0 +1,138 @@
+#include <catch.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "SensorSampler.hpp"
+#include "Seqlock.hpp"
+#include "SimHardware.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+	//three words a torn read would show as a mismatch
+	struct Triple
+	{
+		uint64_t a;
+		uint64_t b;
+		uint64_t c;
+	};
+}
+
+TEST_CASE("Seqlock readers never see a half written value", "[sensorsampler]")
+{
+	Seqlock<Triple> latest;
+	const uint64_t STORES = 200000;
+
+	std::thread writer([&]()
+	{
+		for (uint64_t i = 1; i <= STORES; i++)
+		{
+			Triple value = { i, ~i, i * 3 };
+			latest.store(value);
+		}
+	});
+
+	long long reads = 0;
+	long long torn = 0;
+	uint64_t last = 0;
+	bool ordered = true;
+	while (last < STORES)
+	{
+		Triple value = latest.load();
+		reads++;
+		if (value.a == 0) //still the value from construction
+			continue;
+		if (value.b != ~value.a || value.c != value.a * 3)
+			torn++;
+		if (value.a < last)
+			ordered = false;
+		last = value.a;
+	}
+	writer.join();
+
+	INFO(reads << " reads");
+	REQUIRE(torn == 0);
+	REQUIRE(ordered);
+	REQUIRE(last == STORES);
+}
+
+TEST_CASE("SensorSampler reads each sensor at its own rate", "[sensorsampler]")
+{
+	SimHardware::reset();
+	SensorSampler sampler(200);
+	int fastReads = 0;
+	int slowReads = 0;
+	int oddReads = 0;
+	SampledSensor *fast = sampler.add(200, [&]() { return ++fastReads; });
+	SampledSensor *slow = sampler.add(50, [&]() { return ++slowReads; });
+	SampledSensor *odd = sampler.add(30, [&]() { return ++oddReads; }); //rounds to every 7th tick
+
+	REQUIRE(slow->latest().count == 0);
+	REQUIRE(slow->PIDGet() == 0);
+
+	double start = SimHardware::now();
+	for (int tick = 0; tick < 28; tick++)
+	{
+		sampler.poll();
+		SimHardware::advance(0.005);
+	}
+
+	REQUIRE(fastReads == 28);
+	REQUIRE(slowReads == 7);
+	REQUIRE(oddReads == 4);
+	REQUIRE(fast->get() == 28);
+	REQUIRE(odd->latest().count == 4);
+
+	SensorSample sample = slow->latest();
+	double readAt = sample.time - start;
+	REQUIRE(sample.value == 7);
+	REQUIRE(std::abs(readAt - 24 * 0.005) < 1e-9); //ticks 0, 4, ... 24
+}
+
+TEST_CASE("SensorSampler keeps readers off a slow sensor", "[sensorsampler]")
+{
+	SensorSampler sampler(200);
+	std::atomic<int> reads(0);
+	std::atomic<bool> released(false);
+	SampledSensor *sensor = sampler.add(100, [&]()
+	{
+		int read = ++reads;
+		while (read > 1 && !released) //the second read is a bus transfer that hangs until the test lets it go
+			std::this_thread::yield();
+		return read;
+	});
+	REQUIRE(sampler.add(100, []() { return 0.0; }) != nullptr);
+
+	sampler.start();
+	REQUIRE(sampler.add(100, []() { return 0.0; }) == nullptr);
+
+	while (reads < 2)
+		std::this_thread::yield();
+
+	//the sampler thread is stuck inside read(), and readers still get the last reading
+	double value = 0;
+	for (int i = 0; i < 1000; i++)
+		value = sensor->PIDGet();
+	int readsWhileStuck = reads;
+	SensorSample sample = sensor->latest();
+
+	released = true;
+	sampler.stop();
+
+	REQUIRE(value == 1);
+	REQUIRE(sample.count == 1);
+	REQUIRE(readsWhileStuck == 2);
+}
+
+TEST_CASE("SampledSensor read against calling the sensor", "[.][benchmark]")
+{
+	SensorSampler sampler(200);
+	SampledSensor *sensor = sampler.add(200, []() { return 1.0; });
+	sampler.poll();
+
+	const int READS = 5000000;
+	double sink = 0;
+	double cachedNs = nanosecondsPerIteration(READS, [&](int) { sink += sensor->PIDGet(); });
+	reportBenchmark("SampledSensor::PIDGet", cachedNs);
+	REQUIRE(sink == READS);
+}
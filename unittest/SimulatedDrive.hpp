@@ -0,0 +1,41 @@
+#ifndef SIMULATED_DRIVE_HPP
+#define SIMULATED_DRIVE_HPP
+
+#include <cmath>
+#include "Odometry.hpp"
+#include "DriveConstants.hpp"
+
+//differential drive where each side lags its commanded speed by the motor time constant
+struct SimulatedDrive
+{
+	float leftSpeed, rightSpeed;
+	float leftDistance, rightDistance;
+	Pose pose; //heading counterclockwise, like the gyro
+
+	SimulatedDrive()
+		: leftSpeed(0), rightSpeed(0), leftDistance(0), rightDistance(0)
+	{
+		pose.x = 0;
+		pose.y = 0;
+		pose.heading = 0;
+	}
+
+	void step(float leftOutput, float rightOutput, float dt)
+	{
+		using namespace DriveConstants;
+		const float PI = 3.14159265f;
+
+		leftSpeed += (leftOutput * MAX_VELOCITY - leftSpeed) / MOTOR_TIME_CONSTANT * dt;
+		rightSpeed += (rightOutput * MAX_VELOCITY - rightSpeed) / MOTOR_TIME_CONSTANT * dt;
+		leftDistance += leftSpeed * dt;
+		rightDistance += rightSpeed * dt;
+
+		float heading = pose.heading * PI / 180;
+		float speed = (leftSpeed + rightSpeed) / 2;
+		pose.x += speed * std::cos(heading) * dt;
+		pose.y += speed * std::sin(heading) * dt;
+		pose.heading += (rightSpeed - leftSpeed) / TRACK_WIDTH * dt * 180 / PI;
+	}
+};
+
+#endif
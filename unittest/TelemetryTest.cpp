@@ -0,0 +1,149 @@
+#include <catch.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MpscQueue.hpp"
+#include "Telemetry.hpp"
+#include "AllocationCounter.hpp"
+#include "Benchmark.hpp"
+
+TEST_CASE("MpscQueue keeps every producer's values in order", "[telemetry]")
+{
+	const int PRODUCERS = 4;
+	const int VALUES = 20000;
+	MpscQueue<int, 256> queue;
+
+	std::vector<std::thread> producers;
+	for (int p = 0; p < PRODUCERS; p++)
+	{
+		producers.push_back(std::thread([&queue, p]
+		{
+			for (int i = 0; i < VALUES; i++)
+				while (!queue.push(p * VALUES + i))
+					std::this_thread::yield();
+		}));
+	}
+
+	std::vector<int> next(PRODUCERS, 0);
+	int received = 0;
+	bool ordered = true;
+	while (received < PRODUCERS * VALUES)
+	{
+		int value;
+		if (!queue.pop(value))
+			continue;
+		int producer = value / VALUES;
+		ordered = ordered && value % VALUES == next[producer];
+		next[producer]++;
+		received++;
+	}
+	for (std::thread &producer : producers)
+		producer.join();
+
+	REQUIRE(ordered);
+	int value;
+	REQUIRE_FALSE(queue.pop(value));
+}
+
+TEST_CASE("MpscQueue refuses values when full", "[telemetry]")
+{
+	MpscQueue<int, 4> queue;
+	for (int i = 0; i < 4; i++)
+		REQUIRE(queue.push(i));
+	REQUIRE_FALSE(queue.push(4));
+
+	int value;
+	REQUIRE(queue.pop(value));
+	REQUIRE(value == 0);
+	REQUIRE(queue.push(4));
+}
+
+TEST_CASE("Telemetry formats samples with their channel's field names", "[telemetry]")
+{
+	Telemetry telemetry;
+	Telemetry::Channel turn = telemetry.channel("axis turn", "target  error timedOut");
+	Telemetry::Channel event = telemetry.channel("queue full", "");
+
+	REQUIRE(telemetry.record(turn, 90, 0.5f, 0));
+	REQUIRE(telemetry.record(event));
+
+	std::ostringstream out;
+	REQUIRE(telemetry.drain(out) == 2);
+	std::string text = out.str();
+	REQUIRE(text.find("] axis turn: target=90 error=0.5 timedOut=0\n") != std::string::npos);
+	REQUIRE(text.find("] queue full:\n") != std::string::npos);
+	REQUIRE(telemetry.drain(out) == 0);
+}
+
+TEST_CASE("Telemetry drops samples instead of blocking when the buffer is full", "[telemetry]")
+{
+	Telemetry telemetry;
+	Telemetry::Channel channel = telemetry.channel("flood", "i");
+
+	std::size_t before = allocationCount();
+	for (std::size_t i = 0; i < Telemetry::CAPACITY + 10; i++)
+		telemetry.record(channel, i);
+	std::size_t after = allocationCount();
+
+	REQUIRE(after == before);
+	REQUIRE(telemetry.getDropped() == 10);
+
+	std::ostringstream out;
+	REQUIRE(telemetry.drain(out) == Telemetry::CAPACITY);
+}
+
+TEST_CASE("Telemetry drains on its background thread", "[telemetry]")
+{
+	Telemetry telemetry;
+	Telemetry::Channel channel = telemetry.channel("loop", "count");
+	std::ostringstream out;
+	telemetry.start(out, 0.001);
+	REQUIRE(telemetry.isRunning());
+
+	for (int i = 0; i < 100; i++)
+		telemetry.record(channel, i);
+	telemetry.stop();
+
+	REQUIRE_FALSE(telemetry.isRunning());
+	REQUIRE(out.str().find("loop: count=99\n") != std::string::npos);
+}
+
+TEST_CASE("Verbose telemetry is compiled out with its arguments", "[telemetry]")
+{
+	int evaluated = 0;
+	auto expensive = [&evaluated] { evaluated++; return 1.f; };
+	TELEMETRY_VERBOSE_RECORD(0, expensive());
+	(void)expensive;
+	REQUIRE(evaluated == TELEMETRY_VERBOSE);
+}
+
+TEST_CASE("Telemetry record vs flushed console line", "[.][benchmark]")
+{
+	Telemetry telemetry;
+	Telemetry::Channel channel = telemetry.channel("encoders", "left right");
+	std::ostringstream sink;
+
+	//the buffer is drained between batches, outside the timing, as the drain thread would
+	const int BATCHES = 100;
+	double recorded = 0;
+	for (int batch = 0; batch < BATCHES; batch++)
+	{
+		recorded += nanosecondsPerIteration(Telemetry::CAPACITY, [&](int i)
+		{
+			telemetry.record(channel, i, -i);
+		}) / BATCHES;
+		telemetry.drain(sink);
+	}
+	reportBenchmark("Telemetry::record, two values", recorded);
+
+	std::ofstream console("/dev/null");
+	double printed = nanosecondsPerIteration(100000, [&](int i)
+	{
+		console << "left  \t" << i << std::endl;
+		console << "right \t" << -i << std::endl;
+	});
+	reportBenchmark("two std::endl lines", printed);
+	REQUIRE(recorded < printed);
+}
@@ -0,0 +1,125 @@
+#include "DriveSimulator.hpp"
+#include "SimHardware.hpp"
+#include "DriveAuto.hpp"
+#include "RobotLocation.hpp"
+#include "DriveConstants.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+	//ports and wiring as set up by DriveAuto, RobotLocation and Robot's Shifter
+	const uint32_t LEFT_TALONS[] = { 4, 5 };   //inverted
+	const uint32_t RIGHT_TALONS[] = { 2, 3 };
+	const uint32_t LEFT_ENCODER = 0;           //reversed, positive distance per pulse
+	const uint32_t RIGHT_ENCODER = 2;          //reversed, negative distance per pulse
+	const uint32_t GYRO = 5;
+	const uint32_t SHIFTER = 0;                //kReverse is high gear
+	const double INCHES_PER_PULSE = 0.01031292364;
+
+	//DriveAuto's motor groups print when they are built
+	class QuietOutput
+	{
+	public:
+		QuietOutput() : old(std::cout.rdbuf(sink.rdbuf())) {}
+		~QuietOutput() { std::cout.rdbuf(old); }
+	private:
+		std::ostringstream sink;
+		std::streambuf *old;
+	};
+}
+
+constexpr double DriveSimulator::PHYSICS_PERIOD;
+
+DriveSimulator::DriveSimulator(const DrivetrainParameters &parameters)
+	: model(parameters)
+	, nextSample(0)
+{
+}
+
+const DrivetrainModel& DriveSimulator::getModel() const
+{
+	return model;
+}
+
+void DriveSimulator::writeSensors()
+{
+	SimHardware::setEncoder(LEFT_ENCODER, static_cast<int32_t>(-model.getLeftDistance() / INCHES_PER_PULSE),
+	                        -model.getLeftSpeed() / INCHES_PER_PULSE);
+	SimHardware::setEncoder(RIGHT_ENCODER, static_cast<int32_t>(model.getRightDistance() / INCHES_PER_PULSE),
+	                        model.getRightSpeed() / INCHES_PER_PULSE);
+	SimHardware::setGyro(GYRO, model.getHeading(), model.getTurnRate());
+}
+
+void DriveSimulator::sampleSensors()
+{
+	if (SimHardware::now() < nextSample - PHYSICS_PERIOD / 2)
+		return;
+	RobotLocation::get()->pollSampling();
+	nextSample = SimHardware::now() + 1 / DriveConstants::SAMPLER_RATE;
+}
+
+void DriveSimulator::reset()
+{
+	QuietOutput quiet;
+	DriveAuto::get()->panic();
+	SimHardware::reset();
+	model.reset();
+	writeSensors();
+	nextSample = 0;
+	sampleSensors();
+	RobotLocation::get()->resetPose();
+}
+
+void DriveSimulator::step(double seconds)
+{
+	for (double t = 0; t < seconds - PHYSICS_PERIOD / 2; t += PHYSICS_PERIOD)
+	{
+		double left = -(SimHardware::getPWM(LEFT_TALONS[0]) + SimHardware::getPWM(LEFT_TALONS[1])) / 2;
+		double right = (SimHardware::getPWM(RIGHT_TALONS[0]) + SimHardware::getPWM(RIGHT_TALONS[1])) / 2;
+		bool highGear = SimHardware::getSolenoid(SHIFTER) == DoubleSolenoid::kReverse;
+
+		model.step(left, right, highGear, PHYSICS_PERIOD);
+		SimHardware::advance(PHYSICS_PERIOD);
+		writeSensors();
+		sampleSensors();
+	}
+}
+
+SimulationResult DriveSimulator::run(const std::function<void()> &queue, double timeLimit, double controlPeriod)
+{
+	typedef std::chrono::steady_clock Clock;
+	DriveAuto *drive = DriveAuto::get();
+	queue();
+
+	SimulationResult result = SimulationResult();
+	double cpu = 0;
+	int cycles = 0;
+	double elapsed = 0;
+	auto wallStart = Clock::now();
+	while (drive->getQueueDepth() > 0 && elapsed < timeLimit)
+	{
+		auto start = Clock::now();
+		drive->update();
+		double micros = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+		cpu += micros;
+		result.maxCycleMicros = std::max(result.maxCycleMicros, micros);
+		cycles++;
+
+		step(controlPeriod);
+		elapsed += controlPeriod;
+	}
+	double wall = std::chrono::duration<double>(Clock::now() - wallStart).count();
+
+	result.seconds = elapsed;
+	result.finished = drive->getQueueDepth() == 0;
+	result.pose.x = model.getX();
+	result.pose.y = model.getY();
+	result.pose.heading = model.getHeading();
+	result.cycleMicros = cycles > 0 ? cpu / cycles : 0;
+	result.cyclesPerSecond = wall > 0 ? cycles / wall : 0;
+	result.realTimeFactor = wall > 0 ? elapsed / wall : 0;
+	return result;
+}
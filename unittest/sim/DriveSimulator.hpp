@@ -0,0 +1,49 @@
+#ifndef DRIVE_SIMULATOR_HPP
+#define DRIVE_SIMULATOR_HPP
+
+#include <functional>
+#include "DrivetrainModel.hpp"
+#include "Odometry.hpp"
+
+struct SimulationResult
+{
+	double seconds;         //simulated time until DriveAuto's queue emptied
+	bool finished;          //false when the time limit ran out first
+	Pose pose;              //true pose when it finished
+	double cyclesPerSecond; //simulated control cycles per wall clock second
+	double cycleMicros;     //mean CPU time of one DriveAuto::update()
+	double maxCycleMicros;
+	double realTimeFactor;  //simulated seconds per wall clock second
+};
+
+/**
+ * Runs the real DriveAuto against a DrivetrainModel on the virtual clock.
+ * Motor outputs are read from the Talon PWM channels and the gear from the
+ * Shifter solenoid, and the model's wheels and frame are written back as
+ * encoder counts and a gyro angle, using the same ports as the robot.
+ * RobotLocation's sampler thread isn't started; its ticks run here instead.
+ */
+class DriveSimulator
+{
+public:
+	static constexpr double PHYSICS_PERIOD = 0.0005;
+
+	explicit DriveSimulator(const DrivetrainParameters &parameters);
+
+	void reset(); //robot at rest at the origin, DriveAuto emptied, odometry zeroed
+	void step(double seconds); //advances the physics and clock without running DriveAuto
+
+	//queue() adds DriveAuto actions, then update() runs every controlPeriod until the queue empties
+	SimulationResult run(const std::function<void()> &queue, double timeLimit, double controlPeriod = 0.02);
+
+	const DrivetrainModel& getModel() const;
+
+private:
+	void writeSensors();
+	void sampleSensors(); //ticks RobotLocation's sampler at its own rate on the virtual clock
+
+	DrivetrainModel model;
+	double nextSample;
+};
+
+#endif
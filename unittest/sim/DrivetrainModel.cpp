@@ -0,0 +1,167 @@
+#include "DrivetrainModel.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const double GRAVITY = 9.81;
+	const double METERS_TO_INCHES = 1 / 0.0254;
+	const double RADIANS_TO_DEGREES = 180 / 3.14159265358979;
+}
+
+DrivetrainParameters defaultDrivetrain()
+{
+	DrivetrainParameters p;
+	p.mass = 54;
+	p.moment = 4.5;
+	p.trackWidth = 25 * 0.0254;
+	p.wheelRadius = 3 * 0.0254;
+	p.wheelInertia = 0.02;
+	p.lowGear = 12.75;
+	p.highGear = 7.5;
+	p.motorsPerSide = 2;
+	p.stallTorque = 2.42;              //CIM
+	p.freeSpeed = 5310 * 2 * 3.14159265358979 / 60;
+	p.rotorInertia = 7.75e-5;
+	p.efficiency = 0.85;
+	p.friction = 1.0;
+	p.slipStiffness = 6000;
+	p.scrubTorque = 25;
+	p.rollingDrag = 15;
+	return p;
+}
+
+DrivetrainModel::DrivetrainModel(const DrivetrainParameters &parameters)
+	: parameters(parameters)
+{
+	reset();
+}
+
+void DrivetrainModel::reset()
+{
+	x = y = heading = 0;
+	velocity = turnRate = 0;
+	leftWheel = rightWheel = 0;
+	leftAngle = rightAngle = 0;
+	maxSlip = 0;
+}
+
+//traction one side puts on the carpet, advancing that side's wheel speed by dt
+double DrivetrainModel::sideForce(double output, double wheelSpeed, double groundSpeed, double gear, double dt, double &newWheelSpeed) const
+{
+	const DrivetrainParameters &p = parameters;
+	output = std::max(-1.0, std::min(1.0, output));
+
+	//linear torque-speed curve, output scales the voltage
+	double motorSpeed = wheelSpeed * gear;
+	double motorTorque = p.stallTorque * (output - motorSpeed / p.freeSpeed);
+	double wheelTorque = p.motorsPerSide * motorTorque * gear * p.efficiency;
+
+	//the tire grips in proportion to how fast it slides, up to the friction limit
+	double slip = wheelSpeed * p.wheelRadius - groundSpeed;
+	double grip = p.friction * p.mass * GRAVITY / 2;
+	double traction = std::max(-grip, std::min(grip, p.slipStiffness * slip));
+
+	double inertia = p.wheelInertia + p.motorsPerSide * p.rotorInertia * gear * gear;
+	newWheelSpeed = wheelSpeed + (wheelTorque - traction * p.wheelRadius) / inertia * dt;
+	return traction;
+}
+
+void DrivetrainModel::step(double leftOutput, double rightOutput, bool highGear, double dt)
+{
+	const DrivetrainParameters &p = parameters;
+	const double gear = highGear ? p.highGear : p.lowGear;
+	const double halfTrack = p.trackWidth / 2;
+
+	double leftGround = velocity - turnRate * halfTrack;
+	double rightGround = velocity + turnRate * halfTrack;
+	double newLeft, newRight;
+	double leftForce = sideForce(leftOutput, leftWheel, leftGround, gear, dt, newLeft);
+	double rightForce = sideForce(rightOutput, rightWheel, rightGround, gear, dt, newRight);
+	maxSlip = std::max(maxSlip, std::max(std::abs(leftWheel * p.wheelRadius - leftGround),
+	                                     std::abs(rightWheel * p.wheelRadius - rightGround)));
+
+	//rolling drag and scrub only ever slow the robot down, never reverse it
+	double force = leftForce + rightForce;
+	double newVelocity = velocity + force / p.mass * dt;
+	double drag = 2 * p.rollingDrag / p.mass * dt;
+	if (std::abs(newVelocity) <= drag && std::abs(force) <= 2 * p.rollingDrag)
+		newVelocity = 0;
+	else
+		newVelocity -= std::copysign(drag, newVelocity);
+
+	double torque = (rightForce - leftForce) * halfTrack;
+	double newTurnRate = turnRate + torque / p.moment * dt;
+	double scrub = p.scrubTorque / p.moment * dt;
+	if (std::abs(newTurnRate) <= scrub && std::abs(torque) <= p.scrubTorque)
+		newTurnRate = 0;
+	else
+		newTurnRate -= std::copysign(scrub, newTurnRate);
+
+	double middleHeading = heading + turnRate * dt / 2;
+	x += velocity * std::cos(middleHeading) * dt;
+	y += velocity * std::sin(middleHeading) * dt;
+	heading += turnRate * dt;
+	leftAngle += leftWheel * dt;
+	rightAngle += rightWheel * dt;
+
+	velocity = newVelocity;
+	turnRate = newTurnRate;
+	leftWheel = newLeft;
+	rightWheel = newRight;
+}
+
+double DrivetrainModel::getX() const
+{
+	return x * METERS_TO_INCHES;
+}
+
+double DrivetrainModel::getY() const
+{
+	return y * METERS_TO_INCHES;
+}
+
+double DrivetrainModel::getHeading() const
+{
+	return heading * RADIANS_TO_DEGREES;
+}
+
+double DrivetrainModel::getVelocity() const
+{
+	return velocity * METERS_TO_INCHES;
+}
+
+double DrivetrainModel::getTurnRate() const
+{
+	return turnRate * RADIANS_TO_DEGREES;
+}
+
+double DrivetrainModel::getLeftDistance() const
+{
+	return leftAngle * parameters.wheelRadius * METERS_TO_INCHES;
+}
+
+double DrivetrainModel::getRightDistance() const
+{
+	return rightAngle * parameters.wheelRadius * METERS_TO_INCHES;
+}
+
+double DrivetrainModel::getLeftSpeed() const
+{
+	return leftWheel * parameters.wheelRadius * METERS_TO_INCHES;
+}
+
+double DrivetrainModel::getRightSpeed() const
+{
+	return rightWheel * parameters.wheelRadius * METERS_TO_INCHES;
+}
+
+double DrivetrainModel::getMaxSlip() const
+{
+	return maxSlip * METERS_TO_INCHES;
+}
+
+const DrivetrainParameters& DrivetrainModel::getParameters() const
+{
+	return parameters;
+}
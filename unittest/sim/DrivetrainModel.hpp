@@ -0,0 +1,69 @@
+#ifndef DRIVETRAIN_MODEL_HPP
+#define DRIVETRAIN_MODEL_HPP
+
+//Physical description of the drivetrain, SI units throughout
+struct DrivetrainParameters
+{
+	double mass;            //kg, robot with battery and bumpers
+	double moment;          //kg m^2 about the center
+	double trackWidth;      //m between the left and right wheels
+	double wheelRadius;     //m
+	double wheelInertia;    //kg m^2 of the wheels, belts and gears on one side
+	double lowGear;         //motor turns per wheel turn
+	double highGear;
+	int motorsPerSide;
+	double stallTorque;     //N m per motor at 12 V
+	double freeSpeed;       //rad/s per motor at 12 V
+	double rotorInertia;    //kg m^2 per motor
+	double efficiency;      //gearbox
+	double friction;        //tire on carpet
+	double slipStiffness;   //N of traction per m/s the wheel surface slides over the carpet
+	double scrubTorque;     //N m resisting a skid steer turn
+	double rollingDrag;     //N per side while rolling
+};
+
+DrivetrainParameters defaultDrivetrain(); //two CIMs a side through the Shifter gearbox
+
+/**
+ * Differential drive physics: CIM torque-speed curves through either
+ * Shifter gear, wheel slip limited by tire friction, robot mass and
+ * moment of inertia, and the scrub of turning in place.
+ * Each side's wheels have their own speed, so encoders (which read the
+ * wheels) and the gyro (which reads the frame) disagree when a wheel slips.
+ */
+class DrivetrainModel
+{
+public:
+	explicit DrivetrainModel(const DrivetrainParameters &parameters);
+
+	void reset();
+	void step(double leftOutput, double rightOutput, bool highGear, double dt);
+
+	//robot frame: x forward, y to the left, heading counterclockwise; inches and degrees
+	double getX() const;
+	double getY() const;
+	double getHeading() const;
+	double getVelocity() const;       //inches per second
+	double getTurnRate() const;       //degrees per second, counterclockwise
+
+	//wheel surface travel and speed on each side, what the encoders see
+	double getLeftDistance() const;
+	double getRightDistance() const;
+	double getLeftSpeed() const;
+	double getRightSpeed() const;
+
+	double getMaxSlip() const;        //largest wheel slip since reset, inches per second
+	const DrivetrainParameters& getParameters() const;
+
+private:
+	double sideForce(double output, double wheelSpeed, double groundSpeed, double gear, double dt, double &newWheelSpeed) const;
+
+	DrivetrainParameters parameters;
+	double x, y, heading;             //m, m, rad
+	double velocity, turnRate;        //m/s, rad/s
+	double leftWheel, rightWheel;     //rad/s
+	double leftAngle, rightAngle;     //rad
+	double maxSlip;                   //m/s
+};
+
+#endif
@@ -0,0 +1,313 @@
+#include "SimHardware.hpp"
+#include "WPILib.h"
+#include <array>
+
+namespace
+{
+	struct Ports
+	{
+		double time;
+		std::array<float, SimHardware::PWM_CHANNELS> pwm;
+		std::array<int32_t, SimHardware::DIO_CHANNELS> encoderCount;
+		std::array<double, SimHardware::DIO_CHANNELS> encoderRate;
+		std::array<double, SimHardware::ANALOG_CHANNELS> gyroAngle;
+		std::array<double, SimHardware::ANALOG_CHANNELS> gyroRate;
+		std::array<int, SimHardware::SOLENOID_CHANNELS> solenoid;
+	};
+
+	Ports& ports()
+	{
+		static Ports instance = Ports();
+		return instance;
+	}
+}
+
+double SimHardware::now()
+{
+	return ports().time;
+}
+
+void SimHardware::advance(double seconds)
+{
+	ports().time += seconds;
+}
+
+float SimHardware::getPWM(uint32_t channel)
+{
+	return ports().pwm.at(channel);
+}
+
+void SimHardware::setPWM(uint32_t channel, float value)
+{
+	ports().pwm.at(channel) = value;
+}
+
+int32_t SimHardware::getEncoderCount(uint32_t channel)
+{
+	return ports().encoderCount.at(channel);
+}
+
+double SimHardware::getEncoderRate(uint32_t channel)
+{
+	return ports().encoderRate.at(channel);
+}
+
+void SimHardware::setEncoder(uint32_t channel, int32_t count, double rate)
+{
+	ports().encoderCount.at(channel) = count;
+	ports().encoderRate.at(channel) = rate;
+}
+
+double SimHardware::getGyroAngle(uint32_t channel)
+{
+	return ports().gyroAngle.at(channel);
+}
+
+double SimHardware::getGyroRate(uint32_t channel)
+{
+	return ports().gyroRate.at(channel);
+}
+
+void SimHardware::setGyro(uint32_t channel, double angle, double rate)
+{
+	ports().gyroAngle.at(channel) = angle;
+	ports().gyroRate.at(channel) = rate;
+}
+
+int SimHardware::getSolenoid(uint32_t channel)
+{
+	return ports().solenoid.at(channel);
+}
+
+void SimHardware::setSolenoid(uint32_t channel, int value)
+{
+	ports().solenoid.at(channel) = value;
+}
+
+void SimHardware::reset()
+{
+	double time = ports().time;
+	ports() = Ports();
+	ports().time = time;
+}
+
+Timer::Timer()
+	: accumulated(0)
+	, startTime(0)
+	, running(false)
+{
+}
+
+void Timer::Start()
+{
+	if (!running)
+	{
+		startTime = SimHardware::now();
+		running = true;
+	}
+}
+
+void Timer::Stop()
+{
+	if (running)
+	{
+		accumulated += SimHardware::now() - startTime;
+		running = false;
+	}
+}
+
+void Timer::Reset()
+{
+	accumulated = 0;
+	startTime = SimHardware::now();
+}
+
+double Timer::Get() const
+{
+	return accumulated + (running ? SimHardware::now() - startTime : 0);
+}
+
+double Timer::GetFPGATimestamp()
+{
+	return SimHardware::now();
+}
+
+Talon::Talon(uint32_t channel)
+	: channel(channel)
+{
+}
+
+void Talon::Set(float speed, uint8_t)
+{
+	SimHardware::setPWM(channel, speed < -1 ? -1 : (speed > 1 ? 1 : speed));
+}
+
+float Talon::Get()
+{
+	return SimHardware::getPWM(channel);
+}
+
+void Talon::Disable()
+{
+	SimHardware::setPWM(channel, 0);
+}
+
+void Talon::PIDWrite(float output)
+{
+	Set(output);
+}
+
+Encoder::Encoder(uint32_t aChannel, uint32_t, bool reverseDirection)
+	: channel(aChannel)
+	, direction(reverseDirection ? -1 : 1)
+	, distancePerPulse(1)
+	, offset(0)
+	, parameter(kDistance)
+{
+}
+
+int32_t Encoder::Get() const
+{
+	return static_cast<int32_t>(direction * (SimHardware::getEncoderCount(channel) - offset));
+}
+
+double Encoder::GetDistance() const
+{
+	return Get() * distancePerPulse;
+}
+
+double Encoder::GetRate() const
+{
+	return direction * SimHardware::getEncoderRate(channel) * distancePerPulse;
+}
+
+bool Encoder::GetStopped() const
+{
+	return SimHardware::getEncoderRate(channel) == 0;
+}
+
+void Encoder::Reset()
+{
+	offset = SimHardware::getEncoderCount(channel);
+}
+
+void Encoder::SetDistancePerPulse(double distancePerPulse)
+{
+	this->distancePerPulse = distancePerPulse;
+}
+
+void Encoder::SetPIDSourceParameter(PIDSourceParameter parameter)
+{
+	this->parameter = parameter;
+}
+
+double Encoder::PIDGet()
+{
+	return parameter == kRate ? GetRate() : GetDistance();
+}
+
+Gyro::Gyro(int32_t channel)
+	: channel(channel)
+	, offset(0)
+{
+}
+
+float Gyro::GetAngle() const
+{
+	return SimHardware::getGyroAngle(channel) - offset;
+}
+
+double Gyro::GetRate() const
+{
+	return SimHardware::getGyroRate(channel);
+}
+
+void Gyro::Reset()
+{
+	offset = SimHardware::getGyroAngle(channel);
+}
+
+double Gyro::PIDGet()
+{
+	return GetAngle();
+}
+
+PIDController::PIDController(float p, float i, float d, PIDSource *source, PIDOutput *output, float)
+	: p(p), i(i), d(d), f(0), setpoint(0), enabled(false), source(source), output(output)
+{
+}
+
+PIDController::PIDController(float p, float i, float d, float f, PIDSource *source, PIDOutput *output, float)
+	: p(p), i(i), d(d), f(f), setpoint(0), enabled(false), source(source), output(output)
+{
+}
+
+void PIDController::Enable()
+{
+	enabled = true;
+}
+
+void PIDController::Disable()
+{
+	enabled = false;
+}
+
+bool PIDController::IsEnabled() const
+{
+	return enabled;
+}
+
+void PIDController::Reset()
+{
+	enabled = false;
+}
+
+void PIDController::SetPID(float p, float i, float d)
+{
+	SetPID(p, i, d, f);
+}
+
+void PIDController::SetPID(float p, float i, float d, float f)
+{
+	this->p = p;
+	this->i = i;
+	this->d = d;
+	this->f = f;
+}
+
+void PIDController::SetSetpoint(float setpoint)
+{
+	this->setpoint = setpoint;
+}
+
+float PIDController::GetSetpoint() const
+{
+	return setpoint;
+}
+
+void PIDController::SetInputRange(float, float)
+{
+}
+
+void PIDController::SetOutputRange(float, float)
+{
+}
+
+void PIDController::SetTolerance(float)
+{
+}
+
+DoubleSolenoid::DoubleSolenoid(uint32_t forwardChannel, uint32_t)
+	: channel(forwardChannel)
+{
+}
+
+void DoubleSolenoid::Set(Value value)
+{
+	SimHardware::setSolenoid(channel, value);
+}
+
+DoubleSolenoid::Value DoubleSolenoid::Get() const
+{
+	return static_cast<Value>(SimHardware::getSolenoid(channel));
+}
@@ -0,0 +1,38 @@
+#ifndef SIM_HARDWARE_HPP
+#define SIM_HARDWARE_HPP
+
+#include <cstdint>
+
+//Port table and virtual clock behind the simulated WPILib in this directory.
+//Robot code writes outputs and reads sensors through the usual WPILib classes,
+//a simulation reads the outputs and writes the sensors here.
+namespace SimHardware
+{
+	const int PWM_CHANNELS = 20;
+	const int DIO_CHANNELS = 26;
+	const int ANALOG_CHANNELS = 8;
+	const int SOLENOID_CHANNELS = 8;
+
+	double now();                //seconds on the virtual clock
+	void advance(double seconds);
+
+	float getPWM(uint32_t channel);
+	void setPWM(uint32_t channel, float value);
+
+	//encoders are keyed by their A channel
+	int32_t getEncoderCount(uint32_t channel);
+	double getEncoderRate(uint32_t channel); //counts per second
+	void setEncoder(uint32_t channel, int32_t count, double rate);
+
+	double getGyroAngle(uint32_t channel);
+	double getGyroRate(uint32_t channel);
+	void setGyro(uint32_t channel, double angle, double rate);
+
+	//DoubleSolenoid value keyed by its forward channel
+	int getSolenoid(uint32_t channel);
+	void setSolenoid(uint32_t channel, int value);
+
+	void reset(); //outputs and sensors back to zero, the clock keeps running
+}
+
+#endif
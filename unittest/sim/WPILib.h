@@ -0,0 +1,140 @@
+#ifndef SIM_WPILIB_H
+#define SIM_WPILIB_H
+
+//Just enough of WPILib to build the drive code on a desktop.
+//Everything is backed by SimHardware instead of the FPGA, so time only
+//moves when a simulation advances the virtual clock.
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+class PIDSource
+{
+public:
+	enum PIDSourceParameter { kDistance, kRate, kAngle };
+	virtual double PIDGet() = 0;
+	virtual ~PIDSource() {}
+};
+
+class PIDOutput
+{
+public:
+	virtual void PIDWrite(float output) = 0;
+	virtual ~PIDOutput() {}
+};
+
+class SpeedController : public PIDOutput
+{
+public:
+	virtual void Set(float speed, uint8_t syncGroup = 0) = 0;
+	virtual float Get() = 0;
+	virtual void Disable() = 0;
+};
+
+class Timer
+{
+public:
+	Timer();
+	void Start();
+	void Stop();
+	void Reset();
+	double Get() const;
+	static double GetFPGATimestamp();
+
+private:
+	double accumulated;
+	double startTime;
+	bool running;
+};
+
+class Talon : public SpeedController
+{
+public:
+	explicit Talon(uint32_t channel);
+	void Set(float speed, uint8_t syncGroup = 0);
+	float Get();
+	void Disable();
+	void PIDWrite(float output);
+
+private:
+	uint32_t channel;
+};
+
+class Encoder : public PIDSource
+{
+public:
+	Encoder(uint32_t aChannel, uint32_t bChannel, bool reverseDirection = false);
+	int32_t Get() const;
+	double GetDistance() const;
+	double GetRate() const;
+	bool GetStopped() const;
+	void Reset();
+	void SetDistancePerPulse(double distancePerPulse);
+	void SetPIDSourceParameter(PIDSourceParameter parameter);
+	double PIDGet();
+
+private:
+	uint32_t channel;
+	double direction;
+	double distancePerPulse;
+	int32_t offset;
+	PIDSourceParameter parameter;
+};
+
+class Gyro : public PIDSource
+{
+public:
+	explicit Gyro(int32_t channel);
+	float GetAngle() const;
+	double GetRate() const;
+	void Reset();
+	double PIDGet();
+
+private:
+	int32_t channel;
+	double offset;
+};
+
+//holds its gains and setpoint but never runs a loop; only ToteAlign enables one
+class PIDController
+{
+public:
+	PIDController(float p, float i, float d, PIDSource *source, PIDOutput *output, float period = 0.05);
+	PIDController(float p, float i, float d, float f, PIDSource *source, PIDOutput *output, float period = 0.05);
+	virtual ~PIDController() {}
+
+	void Enable();
+	void Disable();
+	bool IsEnabled() const;
+	void Reset();
+	void SetPID(float p, float i, float d);
+	void SetPID(float p, float i, float d, float f);
+	void SetSetpoint(float setpoint);
+	float GetSetpoint() const;
+	void SetInputRange(float minimum, float maximum);
+	void SetOutputRange(float minimum, float maximum);
+	void SetTolerance(float percent);
+
+private:
+	float p, i, d, f;
+	float setpoint;
+	bool enabled;
+	PIDSource *source;
+	PIDOutput *output;
+};
+
+class DoubleSolenoid
+{
+public:
+	enum Value { kOff, kForward, kReverse };
+	DoubleSolenoid(uint32_t forwardChannel, uint32_t reverseChannel);
+	void Set(Value value);
+	Value Get() const;
+
+private:
+	uint32_t channel;
+};
+
+#endif